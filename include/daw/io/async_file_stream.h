@@ -0,0 +1,694 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2019 Darrell Wright
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files( the "Software" ), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and / or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <cerrno>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#if defined( __linux__ ) && defined( __has_include )
+#if __has_include( <linux/io_uring.h> )
+#define DAW_IO_HAS_IO_URING
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#endif
+#endif
+
+#include <daw/daw_exception.h>
+#include <daw/daw_string_view.h>
+#include <daw/daw_traits.h>
+
+#include "fd_stream.h"
+#include "file_stream.h"
+#include "ostreams.h"
+
+namespace daw {
+	namespace io {
+		// io_uring where the kernel allows it and a pool of threads calling
+		// pwrite(2) otherwise
+		enum class async_backend_type { automatic, io_uring, thread_pool };
+
+		namespace impl {
+			// Writes whole buffers at an offset in the background.  A buffer is
+			// identified by its index, wait( ) returns the index of one that has
+			// been written and can be reused
+			class async_backend {
+			public:
+				virtual ~async_backend( ) = default;
+
+				virtual void submit( unsigned buffer, char const *data, size_t size,
+				                     uint64_t offset ) = 0;
+
+				// Blocks until a submitted buffer is done.  ok is false when it
+				// could not be written
+				virtual unsigned wait( bool &ok ) = 0;
+			};
+
+			class thread_pool_backend final : public async_backend {
+				struct job {
+					unsigned buffer;
+					char const *data;
+					size_t size;
+					uint64_t offset;
+				};
+
+				int m_fd;
+				std::mutex m_mutex{};
+				std::condition_variable m_job_ready{};
+				std::condition_variable m_job_done{};
+				std::deque<job> m_jobs{};
+				std::deque<std::pair<unsigned, bool>> m_done{};
+				bool m_stop = false;
+				std::vector<std::thread> m_threads{};
+
+				void run( ) {
+					std::unique_lock<std::mutex> lock( m_mutex );
+					for( ;; ) {
+						m_job_ready.wait( lock, [&] { return m_stop || !m_jobs.empty( ); } );
+						if( m_jobs.empty( ) ) {
+							return;
+						}
+						auto const j = m_jobs.front( );
+						m_jobs.pop_front( );
+						lock.unlock( );
+						bool const ok = pwrite_all( m_fd, j.data, j.size, j.offset );
+						lock.lock( );
+						m_done.emplace_back( j.buffer, ok );
+						m_job_done.notify_one( );
+					}
+				}
+
+			public:
+				thread_pool_backend( int fd, unsigned thread_count )
+				  : m_fd( fd ) {
+					for( unsigned n = 0; n < thread_count; ++n ) {
+						m_threads.emplace_back( [this] { run( ); } );
+					}
+				}
+
+				~thread_pool_backend( ) override {
+					{
+						std::lock_guard<std::mutex> lock( m_mutex );
+						m_stop = true;
+					}
+					m_job_ready.notify_all( );
+					for( auto &t : m_threads ) {
+						t.join( );
+					}
+				}
+
+				void submit( unsigned buffer, char const *data, size_t size,
+				             uint64_t offset ) override {
+					{
+						std::lock_guard<std::mutex> lock( m_mutex );
+						m_jobs.push_back( job{buffer, data, size, offset} );
+					}
+					m_job_ready.notify_one( );
+				}
+
+				unsigned wait( bool &ok ) override {
+					std::unique_lock<std::mutex> lock( m_mutex );
+					m_job_done.wait( lock, [&] { return !m_done.empty( ); } );
+					auto const result = m_done.front( );
+					m_done.pop_front( );
+					ok = result.second;
+					return result.first;
+				}
+			};
+
+#ifdef DAW_IO_HAS_IO_URING
+			// A minimal io_uring with one submission per buffer.  The buffers are
+			// registered with the kernel when allowed and written with
+			// IORING_OP_WRITE_FIXED, or IORING_OP_WRITEV otherwise
+			class io_uring_backend final : public async_backend {
+				struct pending {
+					char const *data = nullptr;
+					size_t size = 0;
+					uint64_t offset = 0;
+					::iovec iov{};
+					// Submitted to the kernel and not yet completed
+					bool in_flight = false;
+				};
+
+				int m_fd;
+				int m_ring_fd = -1;
+				void *m_sq_ring = MAP_FAILED;
+				size_t m_sq_ring_size = 0;
+				void *m_cq_ring = MAP_FAILED;
+				size_t m_cq_ring_size = 0;
+				::io_uring_sqe *m_sqes = nullptr;
+				size_t m_sqes_size = 0;
+				unsigned *m_sq_tail = nullptr;
+				unsigned *m_sq_mask = nullptr;
+				unsigned *m_sq_array = nullptr;
+				unsigned *m_cq_head = nullptr;
+				unsigned *m_cq_tail = nullptr;
+				unsigned *m_cq_mask = nullptr;
+				::io_uring_cqe *m_cqes = nullptr;
+				bool m_is_registered = false;
+				std::vector<pending> m_pending;
+				// Buffers written synchronously after a failed submission
+				std::vector<std::pair<unsigned, bool>> m_ready{};
+				// Waiting for completions failed with something other than EINTR
+				bool m_is_broken = false;
+
+				static unsigned *at( void *ring, uint32_t offset ) noexcept {
+					return reinterpret_cast<unsigned *>( static_cast<char *>( ring ) +
+					                                     offset );
+				}
+
+				void start( unsigned buffer ) noexcept {
+					auto const &p = m_pending[buffer];
+					auto const tail = *m_sq_tail;
+					auto const index = tail & *m_sq_mask;
+					::io_uring_sqe &sqe = m_sqes[index];
+					std::memset( &sqe, 0, sizeof( sqe ) );
+					sqe.fd = m_fd;
+					sqe.off = p.offset;
+					sqe.user_data = buffer;
+					if( m_is_registered ) {
+						sqe.opcode = IORING_OP_WRITE_FIXED;
+						sqe.addr = reinterpret_cast<uintptr_t>( p.data );
+						sqe.len = static_cast<uint32_t>( p.size );
+						sqe.buf_index = static_cast<uint16_t>( buffer );
+					} else {
+						m_pending[buffer].iov = {const_cast<char *>( p.data ), p.size};
+						sqe.opcode = IORING_OP_WRITEV;
+						sqe.addr = reinterpret_cast<uintptr_t>( &m_pending[buffer].iov );
+						sqe.len = 1;
+					}
+					m_sq_array[index] = index;
+					__atomic_store_n( m_sq_tail, tail + 1U, __ATOMIC_RELEASE );
+					for( ;; ) {
+						auto const result =
+						  ::syscall( __NR_io_uring_enter, m_ring_fd, 1U, 0U, 0U, nullptr, 0U );
+						if( result >= 0 ) {
+							m_pending[buffer].in_flight = true;
+							return;
+						}
+						if( errno != EINTR ) {
+							break;
+						}
+					}
+					// The kernel did not take it, take the entry back and write it here
+					__atomic_store_n( m_sq_tail, tail, __ATOMIC_RELEASE );
+					m_ready.emplace_back( buffer,
+					                      pwrite_all( m_fd, p.data, p.size, p.offset ) );
+				}
+
+			public:
+				io_uring_backend( int fd, char *buffers, size_t buffer_bytes,
+				                  unsigned buffer_count )
+				  : m_fd( fd )
+				  , m_pending( buffer_count ) {
+
+					::io_uring_params params{};
+					auto const ring_fd =
+					  ::syscall( __NR_io_uring_setup, buffer_count, &params );
+					if( ring_fd < 0 ) {
+						return;
+					}
+					m_ring_fd = static_cast<int>( ring_fd );
+					m_sq_ring_size =
+					  params.sq_off.array + params.sq_entries * sizeof( unsigned );
+					m_cq_ring_size =
+					  params.cq_off.cqes + params.cq_entries * sizeof( ::io_uring_cqe );
+					if( ( params.features & IORING_FEAT_SINGLE_MMAP ) != 0 ) {
+						if( m_cq_ring_size > m_sq_ring_size ) {
+							m_sq_ring_size = m_cq_ring_size;
+						}
+					}
+					m_sq_ring =
+					  ::mmap( nullptr, m_sq_ring_size, PROT_READ | PROT_WRITE,
+					          MAP_SHARED | MAP_POPULATE, m_ring_fd, IORING_OFF_SQ_RING );
+					if( m_sq_ring == MAP_FAILED ) {
+						return;
+					}
+					if( ( params.features & IORING_FEAT_SINGLE_MMAP ) != 0 ) {
+						m_cq_ring = m_sq_ring;
+					} else {
+						m_cq_ring =
+						  ::mmap( nullptr, m_cq_ring_size, PROT_READ | PROT_WRITE,
+						          MAP_SHARED | MAP_POPULATE, m_ring_fd, IORING_OFF_CQ_RING );
+						if( m_cq_ring == MAP_FAILED ) {
+							return;
+						}
+					}
+					m_sqes_size = params.sq_entries * sizeof( ::io_uring_sqe );
+					void *const sqes =
+					  ::mmap( nullptr, m_sqes_size, PROT_READ | PROT_WRITE,
+					          MAP_SHARED | MAP_POPULATE, m_ring_fd, IORING_OFF_SQES );
+					if( sqes == MAP_FAILED ) {
+						return;
+					}
+					m_sqes = static_cast<::io_uring_sqe *>( sqes );
+					m_sq_tail = at( m_sq_ring, params.sq_off.tail );
+					m_sq_mask = at( m_sq_ring, params.sq_off.ring_mask );
+					m_sq_array = at( m_sq_ring, params.sq_off.array );
+					m_cq_head = at( m_cq_ring, params.cq_off.head );
+					m_cq_tail = at( m_cq_ring, params.cq_off.tail );
+					m_cq_mask = at( m_cq_ring, params.cq_off.ring_mask );
+					m_cqes = reinterpret_cast<::io_uring_cqe *>(
+					  static_cast<char *>( m_cq_ring ) + params.cq_off.cqes );
+
+					// Registered buffers are pinned once instead of on every write
+					std::vector<::iovec> iovs( buffer_count );
+					for( unsigned n = 0; n < buffer_count; ++n ) {
+						iovs[n] = {buffers + n * buffer_bytes, buffer_bytes};
+					}
+					m_is_registered =
+					  ::syscall( __NR_io_uring_register, m_ring_fd,
+					             IORING_REGISTER_BUFFERS, iovs.data( ), buffer_count ) == 0;
+				}
+
+				~io_uring_backend( ) override {
+					if( m_sqes != nullptr ) {
+						::munmap( static_cast<void *>( m_sqes ), m_sqes_size );
+					}
+					if( m_cq_ring != MAP_FAILED && m_cq_ring != m_sq_ring ) {
+						::munmap( m_cq_ring, m_cq_ring_size );
+					}
+					if( m_sq_ring != MAP_FAILED ) {
+						::munmap( m_sq_ring, m_sq_ring_size );
+					}
+					if( m_ring_fd >= 0 ) {
+						::close( m_ring_fd );
+					}
+				}
+
+				io_uring_backend( io_uring_backend const & ) = delete;
+				io_uring_backend &operator=( io_uring_backend const & ) = delete;
+
+				bool is_open( ) const noexcept {
+					return m_sqes != nullptr;
+				}
+
+				void submit( unsigned buffer, char const *data, size_t size,
+				             uint64_t offset ) override {
+					auto &p = m_pending[buffer];
+					p.data = data;
+					p.size = size;
+					p.offset = offset;
+					start( buffer );
+				}
+
+				unsigned wait( bool &ok ) override {
+					for( ;; ) {
+						if( !m_ready.empty( ) ) {
+							auto const result = m_ready.back( );
+							m_ready.pop_back( );
+							ok = result.second;
+							return result.first;
+						}
+						auto const head = *m_cq_head;
+						if( head == __atomic_load_n( m_cq_tail, __ATOMIC_ACQUIRE ) ) {
+							if( !m_is_broken &&
+							    ::syscall( __NR_io_uring_enter, m_ring_fd, 0U, 1U,
+							               IORING_ENTER_GETEVENTS, nullptr, 0U ) >= 0 ) {
+								continue;
+							}
+							if( !m_is_broken && errno == EINTR ) {
+								continue;
+							}
+							// No completions will come, give the buffers back as failed
+							m_is_broken = true;
+							for( unsigned n = 0; n < m_pending.size( ); ++n ) {
+								if( m_pending[n].in_flight ) {
+									m_pending[n].in_flight = false;
+									ok = false;
+									return n;
+								}
+							}
+							continue;
+						}
+						auto const cqe = m_cqes[head & *m_cq_mask];
+						__atomic_store_n( m_cq_head, head + 1U, __ATOMIC_RELEASE );
+						auto const buffer = static_cast<unsigned>( cqe.user_data );
+						auto &p = m_pending[buffer];
+						p.in_flight = false;
+						if( cqe.res < 0 ) {
+							if( cqe.res == -EINTR || cqe.res == -EAGAIN ) {
+								start( buffer );
+								continue;
+							}
+							ok = false;
+							return buffer;
+						}
+						auto const written = static_cast<size_t>( cqe.res );
+						if( written < p.size && written > 0 ) {
+							// Short write, send the rest
+							p.data += written;
+							p.size -= written;
+							p.offset += written;
+							start( buffer );
+							continue;
+						}
+						ok = written == p.size;
+						return buffer;
+					}
+				}
+			};
+#endif
+
+			inline std::unique_ptr<async_backend>
+			make_async_backend( async_backend_type type, int fd, char *buffers,
+			                    size_t buffer_bytes, unsigned buffer_count ) {
+#ifdef DAW_IO_HAS_IO_URING
+				if( type != async_backend_type::thread_pool ) {
+					auto result = std::make_unique<io_uring_backend>(
+					  fd, buffers, buffer_bytes, buffer_count );
+					if( result->is_open( ) ) {
+						return result;
+					}
+				}
+#else
+				(void)buffers;
+				(void)buffer_bytes;
+#endif
+				(void)type;
+				// One thread per buffer in flight up to 4, the writes are to one file
+				auto const threads = buffer_count - 1U < 4U ? buffer_count - 1U : 4U;
+				return std::make_unique<thread_pool_backend>( fd, threads );
+			}
+		} // namespace impl
+
+		// Output to a regular file that is written in the background.  Output is
+		// formatted into one of buffer_count buffers, full buffers are written at
+		// their offset in the file with io_uring or a thread pool while the next
+		// is filled.  When all the others are still being written the stream
+		// waits for one, so no more than buffer_count * buffer_size characters
+		// are held.  Characters are written as is, without the conversion a wide
+		// FILE does
+		template<typename CharT = char>
+		class async_file_stream {
+			int m_fd = -1;
+			bool m_is_owner = true;
+			bool m_failed = false;
+			size_t m_buffer_size;
+			unsigned m_buffer_count;
+			std::unique_ptr<CharT[]> m_buffers;
+			std::vector<unsigned> m_free{};
+			unsigned m_current = 0;
+			size_t m_size = 0;
+			// Bytes of the file submitted so far
+			uint64_t m_offset = 0;
+			unsigned m_in_flight = 0;
+			std::unique_ptr<impl::async_backend> m_backend{};
+
+			CharT *current( ) const noexcept {
+				return m_buffers.get( ) + m_current * m_buffer_size;
+			}
+
+			void reap( ) {
+				bool ok = true;
+				m_free.push_back( m_backend->wait( ok ) );
+				m_failed |= !ok;
+				--m_in_flight;
+			}
+
+			// Hand the current buffer to the backend and move to a free one,
+			// waiting for one when there are none
+			void submit( ) {
+				if( m_size == 0 || !m_backend ) {
+					m_size = 0;
+					return;
+				}
+				auto const bytes = m_size * sizeof( CharT );
+				m_backend->submit( m_current,
+				                   reinterpret_cast<char const *>( current( ) ), bytes,
+				                   m_offset );
+				m_offset += bytes;
+				++m_in_flight;
+				m_size = 0;
+				if( m_free.empty( ) ) {
+					reap( );
+				}
+				m_current = m_free.back( );
+				m_free.pop_back( );
+			}
+
+			void open_backend( async_backend_type type ) {
+				if( m_fd < 0 ) {
+					return;
+				}
+				for( unsigned n = m_buffer_count; n > 1U; --n ) {
+					m_free.push_back( n - 1U );
+				}
+				m_backend = impl::make_async_backend(
+				  type, m_fd, reinterpret_cast<char *>( m_buffers.get( ) ),
+				  m_buffer_size * sizeof( CharT ), m_buffer_count );
+			}
+
+		public:
+			// OutputStream Interface
+			using character_t = CharT;
+
+			static constexpr size_t const default_buffer_size = 256U * 1024U;
+			static constexpr unsigned const default_buffer_count = 8U;
+
+			// fd must be a regular file, writes start at its current offset
+			explicit async_file_stream(
+			  int fd, bool take_ownership, size_t buffer_size = default_buffer_size,
+			  unsigned buffer_count = default_buffer_count,
+			  async_backend_type type = async_backend_type::automatic )
+			  : m_fd( fd )
+			  , m_is_owner( take_ownership )
+			  , m_buffer_size( buffer_size > 0 ? buffer_size : 1U )
+			  , m_buffer_count( buffer_count > 1U ? buffer_count : 2U )
+			  , m_buffers( new CharT[m_buffer_size * m_buffer_count] ) {
+
+				if( m_fd >= 0 ) {
+					auto const pos = ::lseek( m_fd, 0, SEEK_CUR );
+					m_offset = pos > 0 ? static_cast<uint64_t>( pos ) : 0U;
+				}
+				open_backend( type );
+			}
+
+			explicit async_file_stream(
+			  std::string const &file_name,
+			  file_open_flags flags = file_open_flags::Write,
+			  size_t buffer_size = default_buffer_size,
+			  unsigned buffer_count = default_buffer_count,
+			  async_backend_type type = async_backend_type::automatic )
+			  : async_file_stream(
+			      // Appends are written at the end offset, not with O_APPEND
+			      ::open( file_name.c_str( ),
+			              O_WRONLY | O_CREAT | O_CLOEXEC |
+			                ( flags == file_open_flags::Write ? O_TRUNC : 0 ),
+			              0666 ),
+			      true, buffer_size, buffer_count, type ) {
+
+				if( m_fd >= 0 && flags == file_open_flags::Append ) {
+					struct stat st {};
+					if( ::fstat( m_fd, &st ) == 0 ) {
+						m_offset = static_cast<uint64_t>( st.st_size );
+					}
+				}
+			}
+
+			async_file_stream( async_file_stream &&other ) noexcept
+			  : m_fd( std::exchange( other.m_fd, -1 ) )
+			  , m_is_owner( std::exchange( other.m_is_owner, false ) )
+			  , m_failed( other.m_failed )
+			  , m_buffer_size( other.m_buffer_size )
+			  , m_buffer_count( other.m_buffer_count )
+			  , m_buffers( std::move( other.m_buffers ) )
+			  , m_free( std::move( other.m_free ) )
+			  , m_current( other.m_current )
+			  , m_size( std::exchange( other.m_size, 0 ) )
+			  , m_offset( other.m_offset )
+			  , m_in_flight( std::exchange( other.m_in_flight, 0U ) )
+			  , m_backend( std::move( other.m_backend ) ) {}
+
+			async_file_stream &operator=( async_file_stream &&rhs ) noexcept {
+				if( this != &rhs ) {
+					if( m_is_owner ) {
+						close( );
+					} else {
+						flush( );
+					}
+					m_fd = std::exchange( rhs.m_fd, -1 );
+					m_is_owner = std::exchange( rhs.m_is_owner, false );
+					m_failed = rhs.m_failed;
+					m_buffer_size = rhs.m_buffer_size;
+					m_buffer_count = rhs.m_buffer_count;
+					m_buffers = std::move( rhs.m_buffers );
+					m_free = std::move( rhs.m_free );
+					m_current = rhs.m_current;
+					m_size = std::exchange( rhs.m_size, 0 );
+					m_offset = rhs.m_offset;
+					m_in_flight = std::exchange( rhs.m_in_flight, 0U );
+					m_backend = std::move( rhs.m_backend );
+				}
+				return *this;
+			}
+
+			async_file_stream( async_file_stream const & ) = delete;
+			async_file_stream &operator=( async_file_stream const & ) = delete;
+
+			~async_file_stream( ) {
+				if( m_is_owner ) {
+					close( );
+				} else {
+					flush( );
+				}
+			}
+
+			// False when the file is not open or a write has failed
+			inline explicit operator bool( ) const noexcept {
+				return m_fd >= 0 && !m_failed;
+			}
+
+			inline int native_handle( ) const noexcept {
+				return m_fd;
+			}
+
+			// Characters written, including those not yet submitted
+			inline size_t size( ) const noexcept {
+				return static_cast<size_t>( m_offset / sizeof( CharT ) ) + m_size;
+			}
+
+			// OutputStream Interface
+			inline void operator( )( CharT c ) {
+				if( m_size == m_buffer_size ) {
+					submit( );
+				}
+				current( )[m_size++] = c;
+			}
+
+			// OutputStream Interface
+			void operator( )( ::daw::io::impl::accept_sized, CharT const *ptr,
+			                  size_t count ) {
+				while( count > 0 ) {
+					if( m_size == m_buffer_size ) {
+						submit( );
+					}
+					auto const room = m_buffer_size - m_size;
+					auto const sz = count < room ? count : room;
+					impl::copy_chars( current( ) + m_size, ptr, sz );
+					m_size += sz;
+					ptr += sz;
+					count -= sz;
+				}
+			}
+
+			// OutputStream Interface
+			template<typename String,
+			         std::enable_if_t<( ::daw::impl::is_string_like_v<String> &&
+			                            !::daw::traits::is_character_v<String>),
+			                          std::nullptr_t> = nullptr>
+			inline void operator( )( String &&str ) {
+				static_assert(
+				  std::is_same_v<remove_cvref_t<CharT>,
+				                 remove_cvref_t<decltype( *str.data( ) )>>,
+				  "String's data( ) character type must match that of output stream" );
+
+				operator( )( ::daw::io::impl::accept_sized{}, str.data( ),
+				             static_cast<size_t>( str.size( ) ) );
+			}
+
+			// Direct formatting into the current buffer, nullptr when count is
+			// larger than a buffer
+			inline CharT *prepare( size_t count ) {
+				if( count > m_buffer_size ) {
+					return nullptr;
+				}
+				if( count > m_buffer_size - m_size ) {
+					submit( );
+				}
+				return current( ) + m_size;
+			}
+
+			inline void commit( size_t count ) noexcept {
+				m_size += count;
+			}
+
+			using mark_t = size_t;
+
+			inline mark_t mark( ) const noexcept {
+				return size( );
+			}
+
+			// Drop what was written after m.  Submitted buffers may be written
+			// already, when m is from before the buffer being filled only that
+			// buffer is dropped, the stream fails and false is returned
+			inline bool rewind( mark_t m ) noexcept {
+				auto const submitted = static_cast<size_t>( m_offset / sizeof( CharT ) );
+				if( m < submitted ) {
+					m_size = 0;
+					m_failed = true;
+					return false;
+				}
+				m_size = m - submitted;
+				return true;
+			}
+
+			// Submit the current buffer and wait until everything is written
+			void flush( ) {
+				submit( );
+				while( m_in_flight > 0 ) {
+					reap( );
+				}
+			}
+
+			void close( ) {
+				flush( );
+				m_backend.reset( );
+				if( m_fd >= 0 ) {
+					::close( std::exchange( m_fd, -1 ) );
+				}
+			}
+		};
+
+		template<typename CharT>
+		struct supports_output_stream_interface<async_file_stream<CharT>>
+		  : std::true_type {};
+	} // namespace io
+
+	template<typename CharT = char>
+	auto make_async_file_stream(
+	  std::string const &file_name,
+	  io::file_open_flags flags = io::file_open_flags::Write,
+	  size_t buffer_size = io::async_file_stream<CharT>::default_buffer_size,
+	  unsigned buffer_count = io::async_file_stream<CharT>::default_buffer_count,
+	  io::async_backend_type type = io::async_backend_type::automatic ) {
+
+		return io::async_file_stream<CharT>( file_name, flags, buffer_size,
+		                                     buffer_count, type );
+	}
+} // namespace daw
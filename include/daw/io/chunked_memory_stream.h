@@ -0,0 +1,322 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2019 Darrell Wright
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files( the "Software" ), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and / or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#ifndef NOSTRING
+#include <string>
+#endif
+
+#include <daw/daw_string_view.h>
+#include <daw/daw_traits.h>
+
+#include "ostreams.h"
+
+namespace daw {
+	namespace io {
+		// An in memory stream that grows a block at a time and never runs out of
+		// room.  Written data is never moved, the blocks are handed out as a list
+		// of chunks for gather writes.  Blocks are kept for reuse after reset( )
+		template<typename CharT = char, size_t BlockSize = 4096>
+		class chunked_memory_stream {
+			static_assert( BlockSize > 0, "BlockSize must be at least 1" );
+
+			struct block {
+				block *next = nullptr;
+				size_t capacity;
+				size_t size = 0;
+				std::unique_ptr<CharT[]> data;
+
+				explicit block( size_t cap )
+				  : capacity( cap )
+				  , data( new CharT[cap] ) {}
+
+				size_t room( ) const noexcept {
+					return capacity - size;
+				}
+
+				CharT *end( ) const noexcept {
+					return data.get( ) + size;
+				}
+			};
+
+			block *m_first = nullptr;
+			block *m_last = nullptr;
+			// Blocks released by reset( ) waiting to be reused
+			block *m_pool = nullptr;
+			size_t m_size = 0;
+
+			static void free_blocks( block *b ) noexcept {
+				while( b != nullptr ) {
+					delete std::exchange( b, b->next );
+				}
+			}
+
+			// A pooled block with at least n characters or a new one
+			block *take_block( size_t n ) {
+				block **prev = &m_pool;
+				for( block *b = m_pool; b != nullptr; b = b->next ) {
+					if( b->capacity >= n ) {
+						*prev = b->next;
+						b->next = nullptr;
+						b->size = 0;
+						return b;
+					}
+					prev = &b->next;
+				}
+				return new block( n > BlockSize ? n : BlockSize );
+			}
+
+			// The end of the last block, adding one when there are fewer than n
+			// characters left in it
+			CharT *room_for( size_t n ) {
+				if( m_last == nullptr || m_last->room( ) < n ) {
+					block *b = take_block( n );
+					if( m_last == nullptr ) {
+						m_first = b;
+					} else {
+						m_last->next = b;
+					}
+					m_last = b;
+				}
+				return m_last->end( );
+			}
+
+		public:
+			// OutputStream Interface
+			using character_t = CharT;
+
+			chunked_memory_stream( ) noexcept = default;
+
+			chunked_memory_stream( chunked_memory_stream &&other ) noexcept
+			  : m_first( std::exchange( other.m_first, nullptr ) )
+			  , m_last( std::exchange( other.m_last, nullptr ) )
+			  , m_pool( std::exchange( other.m_pool, nullptr ) )
+			  , m_size( std::exchange( other.m_size, 0 ) ) {}
+
+			chunked_memory_stream &operator=( chunked_memory_stream &&rhs ) noexcept {
+				if( this != &rhs ) {
+					free_blocks( m_first );
+					free_blocks( m_pool );
+					m_first = std::exchange( rhs.m_first, nullptr );
+					m_last = std::exchange( rhs.m_last, nullptr );
+					m_pool = std::exchange( rhs.m_pool, nullptr );
+					m_size = std::exchange( rhs.m_size, 0 );
+				}
+				return *this;
+			}
+
+			chunked_memory_stream( chunked_memory_stream const & ) = delete;
+			chunked_memory_stream &
+			operator=( chunked_memory_stream const & ) = delete;
+
+			~chunked_memory_stream( ) {
+				free_blocks( m_first );
+				free_blocks( m_pool );
+			}
+
+			size_t size( ) const noexcept {
+				return m_size;
+			}
+
+			bool empty( ) const noexcept {
+				return m_size == 0;
+			}
+
+			// OutputStream Interface
+			void operator( )( CharT c ) {
+				*room_for( 1 ) = c;
+				++m_last->size;
+				++m_size;
+			}
+
+			// OutputStream Interface
+			void operator( )( ::daw::io::impl::accept_sized, CharT const *ptr,
+			                  size_t count ) {
+				m_size += count;
+				// Fill what is left of the last block before starting another
+				while( count > 0 ) {
+					CharT *const out = room_for( 1 );
+					auto const sz = m_last->room( ) < count ? m_last->room( ) : count;
+					impl::copy_chars( out, ptr, sz );
+					m_last->size += sz;
+					ptr += sz;
+					count -= sz;
+				}
+			}
+
+			// OutputStream Interface
+			template<typename String,
+			         std::enable_if_t<( ::daw::impl::is_string_like_v<String> &&
+			                            !::daw::traits::is_character_v<String>),
+			                          std::nullptr_t> = nullptr>
+			void operator( )( String &&str ) {
+				static_assert(
+				  std::is_same_v<remove_cvref_t<CharT>,
+				                 remove_cvref_t<decltype( *str.data( ) )>>,
+				  "String's data( ) character type must match that of output stream" );
+
+				operator( )( ::daw::io::impl::accept_sized{}, str.data( ),
+				             static_cast<size_t>( str.size( ) ) );
+			}
+
+			// Direct formatting, there is always room.  The rest of the last block
+			// is left unused when it is smaller than n
+			CharT *prepare( size_t n ) {
+				return room_for( n );
+			}
+
+			void commit( size_t n ) noexcept {
+				m_last->size += n;
+				m_size += n;
+			}
+
+			// Keep the blocks for reuse
+			void reset( ) noexcept {
+				if( m_last != nullptr ) {
+					m_last->next = m_pool;
+					m_pool = m_first;
+				}
+				m_first = nullptr;
+				m_last = nullptr;
+				m_size = 0;
+			}
+
+			// The last block and how much of it was used
+			struct mark_t {
+				block *last;
+				size_t last_size;
+				size_t size;
+			};
+
+			mark_t mark( ) const noexcept {
+				return {m_last, m_last == nullptr ? 0U : m_last->size, m_size};
+			}
+
+			// Drop what was written after m, blocks started since then go to the
+			// pool.  Always possible
+			bool rewind( mark_t m ) noexcept {
+				block *const added = m.last == nullptr ? m_first : m.last->next;
+				if( added != nullptr ) {
+					m_last->next = m_pool;
+					m_pool = added;
+				}
+				m_last = m.last;
+				if( m_last == nullptr ) {
+					m_first = nullptr;
+				} else {
+					m_last->next = nullptr;
+					m_last->size = m.last_size;
+				}
+				m_size = m.size;
+				return true;
+			}
+
+			// Release all memory, including that of the pool
+			void clear( ) noexcept {
+				free_blocks( m_first );
+				free_blocks( m_pool );
+				m_first = nullptr;
+				m_last = nullptr;
+				m_pool = nullptr;
+				m_size = 0;
+			}
+
+			// Call func with a daw::basic_string_view<CharT> for each non-empty chunk
+			// in order
+			template<typename Function>
+			void for_each_chunk( Function &&func ) const {
+				for( block const *b = m_first; b != nullptr; b = b->next ) {
+					if( b->size > 0 ) {
+						func( ::daw::basic_string_view<CharT>( b->data.get( ), b->size ) );
+					}
+				}
+			}
+
+			size_t chunk_count( ) const noexcept {
+				size_t result = 0;
+				for( block const *b = m_first; b != nullptr; b = b->next ) {
+					if( b->size > 0 ) {
+						++result;
+					}
+				}
+				return result;
+			}
+
+			std::vector<::daw::basic_string_view<CharT>> chunks( ) const {
+				std::vector<::daw::basic_string_view<CharT>> result{};
+				result.reserve( chunk_count( ) );
+				for_each_chunk( [&]( auto chunk ) { result.push_back( chunk ); } );
+				return result;
+			}
+
+			// Fill up to count iovec like structures(with iov_base and iov_len
+			// members) from the chunks, returning how many were filled
+			template<typename IOVec>
+			size_t fill_iovecs( IOVec *iovs, size_t count ) const noexcept {
+				size_t n = 0;
+				for( block const *b = m_first; b != nullptr && n < count;
+				     b = b->next ) {
+					if( b->size > 0 ) {
+						iovs[n].iov_base = static_cast<void *>( b->data.get( ) );
+						iovs[n].iov_len = b->size * sizeof( CharT );
+						++n;
+					}
+				}
+				return n;
+			}
+
+			// Copy the contents to dest, which must have room for size( )
+			// characters
+			CharT *copy_to( CharT *dest ) const noexcept {
+				for_each_chunk( [&]( auto chunk ) {
+					for( auto c : chunk ) {
+						*dest++ = c;
+					}
+				} );
+				return dest;
+			}
+
+#ifndef NOSTRING
+			std::basic_string<CharT> to_os_string( ) const {
+				std::basic_string<CharT> result( m_size, CharT{} );
+				copy_to( result.data( ) );
+				return result;
+			}
+#endif
+		};
+
+		template<typename CharT, size_t BlockSize>
+		struct supports_output_stream_interface<
+		  chunked_memory_stream<CharT, BlockSize>> : std::true_type {};
+
+		template<typename CharT = char, size_t BlockSize = 4096>
+		auto make_chunked_memory_stream( ) {
+			return chunked_memory_stream<CharT, BlockSize>( );
+		}
+	} // namespace io
+} // namespace daw
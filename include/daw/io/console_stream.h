@@ -30,7 +30,8 @@ namespace daw {
 	namespace io {
 		enum class output_stream_type_destinations { output, error };
 
-		template<typename CharT, output_stream_type_destinations Dest>
+		template<typename CharT, output_stream_type_destinations Dest,
+		         locking_policy Locking = locking_policy::locked>
 		struct console_stream {
 			using character_t = CharT;
 
@@ -46,18 +47,29 @@ namespace daw {
 			}
 
 		public:
+			// Hold the lock for the rest of the statement,
+			// daw::con_out.locked( ) << a << b;
+			inline locked_file_stream<CharT> locked( ) const noexcept {
+				return locked_file_stream<CharT>( get_handle( ) );
+			}
+
 			inline auto operator( )( CharT c ) const noexcept {
-				return impl::write_char{}( c, get_handle( ) );
+				return impl::write_char<Locking>{}( c, get_handle( ) );
 			}
 
 			inline auto operator( )( ::daw::io::impl::accept_asciiz,
 			                         CharT const *ptr ) const noexcept {
-				return impl::write_char{}( ptr, get_handle( ) );
+				return impl::write_char<Locking>{}( ptr, get_handle( ) );
 			}
 
 			template<size_t N>
 			inline auto operator( )( CharT const ( &str )[N] ) const noexcept {
-				return impl::write_char{}( str, N - 1, get_handle( ) );
+				return impl::write_char<Locking>{}( str, N - 1, get_handle( ) );
+			}
+
+			inline auto operator( )( ::daw::io::impl::accept_sized, CharT const *ptr,
+			                         size_t count ) const noexcept {
+				return impl::write_char<Locking>{}( ptr, count, get_handle( ) );
 			}
 			// OutputStream Interface
 			template<typename String,
@@ -70,13 +82,14 @@ namespace daw {
 				                 remove_cvref_t<decltype( *str.data( ) )>>,
 				  "String's data( ) character type must match that of output stream" );
 
-				impl::write_char{}( str.data( ), str.size( ), get_handle( ) );
+				impl::write_char<Locking>{}( str.data( ), str.size( ), get_handle( ) );
 			}
 		};
 
-		template<typename CharT, output_stream_type_destinations Dest>
-		struct supports_output_stream_interface<console_stream<CharT, Dest>>
-		  : std::true_type {};
+		template<typename CharT, output_stream_type_destinations Dest,
+		         locking_policy Locking>
+		struct supports_output_stream_interface<
+		  console_stream<CharT, Dest, Locking>> : std::true_type {};
 	} // namespace io
 
 #ifdef stdout
@@ -84,12 +97,25 @@ namespace daw {
 	  io::console_stream<char, io::output_stream_type_destinations::output>{};
 	constexpr auto con_wout =
 	  io::console_stream<wchar_t, io::output_stream_type_destinations::output>{};
+	// For programs that write to stdout from one thread only
+	constexpr auto con_out_unlocked =
+	  io::console_stream<char, io::output_stream_type_destinations::output,
+	                     io::locking_policy::unlocked>{};
+	constexpr auto con_wout_unlocked =
+	  io::console_stream<wchar_t, io::output_stream_type_destinations::output,
+	                     io::locking_policy::unlocked>{};
 #endif
 #ifdef stderr
 	constexpr auto con_err =
 	  io::console_stream<char, io::output_stream_type_destinations::error>{};
 	constexpr auto con_werr =
 	  io::console_stream<wchar_t, io::output_stream_type_destinations::error>{};
+	constexpr auto con_err_unlocked =
+	  io::console_stream<char, io::output_stream_type_destinations::error,
+	                     io::locking_policy::unlocked>{};
+	constexpr auto con_werr_unlocked =
+	  io::console_stream<wchar_t, io::output_stream_type_destinations::error,
+	                     io::locking_policy::unlocked>{};
 #endif
 
 } // namespace daw
@@ -0,0 +1,101 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2019 Darrell Wright
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files( the "Software" ), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and / or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <cstddef>
+
+#include <daw/daw_traits.h>
+
+#include "ostreams.h"
+
+namespace daw {
+	namespace io {
+		// An OutputStream that only keeps the number of characters written to it.
+		// Numbers are measured without being formatted where the converter
+		// allows it.  Used to find the exact buffer size needed before writing
+		template<typename CharT = char>
+		class counting_stream {
+			size_t m_size = 0;
+
+		public:
+			// OutputStream Interface
+			using character_t = CharT;
+
+			constexpr counting_stream( ) noexcept = default;
+
+			constexpr size_t size( ) const noexcept {
+				return m_size;
+			}
+
+			constexpr void reset( ) noexcept {
+				m_size = 0;
+			}
+
+			using mark_t = size_t;
+
+			constexpr mark_t mark( ) const noexcept {
+				return m_size;
+			}
+
+			constexpr bool rewind( mark_t m ) noexcept {
+				m_size = m;
+				return true;
+			}
+
+			// OutputStream Interface
+			constexpr void operator( )( CharT ) noexcept {
+				++m_size;
+			}
+
+			// OutputStream Interface
+			constexpr void operator( )( ::daw::io::impl::accept_sized, CharT const *,
+			                            size_t count ) noexcept {
+				m_size += count;
+			}
+
+			// OutputStream Interface
+			constexpr void operator( )( ::daw::io::impl::accept_length,
+			                            size_t count ) noexcept {
+				m_size += count;
+			}
+
+			// OutputStream Interface
+			template<typename String,
+			         std::enable_if_t<( ::daw::impl::is_string_like_v<String> &&
+			                            !::daw::traits::is_character_v<String>),
+			                          std::nullptr_t> = nullptr>
+			constexpr void operator( )( String &&str ) noexcept {
+				m_size += static_cast<size_t>( str.size( ) );
+			}
+		};
+
+		template<typename CharT>
+		struct supports_output_stream_interface<counting_stream<CharT>>
+		  : std::true_type {};
+
+		template<typename CharT = char>
+		constexpr auto make_counting_stream( ) noexcept {
+			return counting_stream<CharT>( );
+		}
+	} // namespace io
+} // namespace daw
@@ -0,0 +1,344 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2019 Darrell Wright
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files( the "Software" ), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and / or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <string>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <daw/daw_exception.h>
+#include <daw/daw_string_view.h>
+#include <daw/daw_traits.h>
+
+#include "fd_stream.h"
+#include "file_stream.h"
+#include "ostreams.h"
+
+namespace daw {
+	namespace io {
+		namespace impl {
+			struct aligned_free {
+				void operator( )( void *ptr ) const noexcept {
+					std::free( ptr );
+				}
+			};
+
+			// Open file_name for writes that bypass the page cache.  Falls back to
+			// a normal open when the file system does not allow it
+			inline int open_direct( std::string const &file_name,
+			                        file_open_flags flags, bool &is_direct ) {
+				// Appends read back the partial last block
+				int const mode =
+				  ( flags == file_open_flags::Write ? O_WRONLY | O_TRUNC : O_RDWR ) |
+				  O_CREAT | O_CLOEXEC;
+#if defined( O_DIRECT )
+				int fd = ::open( file_name.c_str( ), mode | O_DIRECT, 0666 );
+				if( fd >= 0 ) {
+					is_direct = true;
+					return fd;
+				}
+				if( errno != EINVAL ) {
+					return fd;
+				}
+#endif
+				fd = ::open( file_name.c_str( ), mode, 0666 );
+#if defined( F_NOCACHE )
+				is_direct = fd >= 0 && ::fcntl( fd, F_NOCACHE, 1 ) == 0;
+#else
+				is_direct = false;
+#endif
+				return fd;
+			}
+		} // namespace impl
+
+		// Output to a file opened with O_DIRECT, for large files that should not
+		// fill the page cache.  Output is formatted into one page aligned buffer
+		// of buffer_size bytes, rounded to whole blocks, and only whole blocks
+		// are written.  On close the last partial block is written padded and the
+		// file is cut to the size written.  Characters are written as is, without
+		// the conversion a wide FILE does
+		template<typename CharT = char>
+		class direct_file_stream {
+			// Set when opening, before m_fd
+			bool m_is_direct = false;
+			int m_fd = -1;
+			bool m_failed = false;
+			size_t m_capacity;
+			std::unique_ptr<CharT, impl::aligned_free> m_buffer{};
+			size_t m_size = 0;
+			// Bytes written to the file, always whole blocks
+			uint64_t m_offset = 0;
+
+			static constexpr size_t const alignment = 4096U;
+
+			CharT *buffer( ) const noexcept {
+				return m_buffer.get( );
+			}
+
+			// Write the whole blocks in the buffer and move what is left to the
+			// front
+			void write_blocks( ) noexcept {
+				auto const bytes = m_size * sizeof( CharT );
+				auto const whole = bytes - bytes % alignment;
+				if( whole == 0 || m_fd < 0 ) {
+					return;
+				}
+				m_failed |= !impl::pwrite_all(
+				  m_fd, reinterpret_cast<char const *>( buffer( ) ), whole, m_offset );
+				m_offset += whole;
+				auto const rest = m_size - whole / sizeof( CharT );
+				std::memmove( buffer( ), buffer( ) + whole / sizeof( CharT ),
+				              rest * sizeof( CharT ) );
+				m_size = rest;
+			}
+
+			// Start from the last partial block of an existing file
+			void load_tail( ) noexcept {
+				struct stat st {};
+				if( ::fstat( m_fd, &st ) != 0 ) {
+					m_failed = true;
+					return;
+				}
+				auto const size = static_cast<uint64_t>( st.st_size );
+				m_offset = size - size % alignment;
+				auto const tail = static_cast<size_t>( size - m_offset );
+				if( tail == 0 ) {
+					return;
+				}
+				auto const result = ::pread( m_fd, buffer( ), alignment,
+				                             static_cast<off_t>( m_offset ) );
+				if( result != static_cast<ssize_t>( tail ) ) {
+					m_failed = true;
+					return;
+				}
+				m_size = ( tail + sizeof( CharT ) - 1U ) / sizeof( CharT );
+			}
+
+		public:
+			// OutputStream Interface
+			using character_t = CharT;
+
+			static constexpr size_t const default_buffer_size = 1024U * 1024U;
+
+			explicit direct_file_stream(
+			  std::string const &file_name,
+			  file_open_flags flags = file_open_flags::Write,
+			  size_t buffer_size = default_buffer_size )
+			  : m_fd( impl::open_direct( file_name, flags, m_is_direct ) )
+			  , m_capacity( ( ( buffer_size + alignment - 1U ) / alignment *
+			                  alignment ) /
+			                sizeof( CharT ) ) {
+
+				if( m_capacity == 0 ) {
+					m_capacity = alignment / sizeof( CharT );
+				}
+				void *ptr = nullptr;
+				if( ::posix_memalign( &ptr, alignment, m_capacity * sizeof( CharT ) ) !=
+				    0 ) {
+					if( m_fd >= 0 ) {
+						::close( m_fd );
+					}
+					throw std::bad_alloc( );
+				}
+				m_buffer.reset( static_cast<CharT *>( ptr ) );
+				if( m_fd >= 0 && flags == file_open_flags::Append ) {
+					load_tail( );
+				}
+			}
+
+			direct_file_stream( direct_file_stream &&other ) noexcept
+			  : m_is_direct( other.m_is_direct )
+			  , m_fd( std::exchange( other.m_fd, -1 ) )
+			  , m_failed( other.m_failed )
+			  , m_capacity( other.m_capacity )
+			  , m_buffer( std::move( other.m_buffer ) )
+			  , m_size( std::exchange( other.m_size, 0 ) )
+			  , m_offset( other.m_offset ) {}
+
+			direct_file_stream &operator=( direct_file_stream &&rhs ) noexcept {
+				if( this != &rhs ) {
+					close( );
+					m_fd = std::exchange( rhs.m_fd, -1 );
+					m_is_direct = rhs.m_is_direct;
+					m_failed = rhs.m_failed;
+					m_capacity = rhs.m_capacity;
+					m_buffer = std::move( rhs.m_buffer );
+					m_size = std::exchange( rhs.m_size, 0 );
+					m_offset = rhs.m_offset;
+				}
+				return *this;
+			}
+
+			direct_file_stream( direct_file_stream const & ) = delete;
+			direct_file_stream &operator=( direct_file_stream const & ) = delete;
+
+			~direct_file_stream( ) {
+				close( );
+			}
+
+			// False when the file is not open or a write has failed
+			inline explicit operator bool( ) const noexcept {
+				return m_fd >= 0 && !m_failed;
+			}
+
+			// Whether the page cache is bypassed, false when the file system does
+			// not support it
+			inline bool is_direct( ) const noexcept {
+				return m_is_direct;
+			}
+
+			inline int native_handle( ) const noexcept {
+				return m_fd;
+			}
+
+			// Characters in the file, including those there before an append
+			inline size_t size( ) const noexcept {
+				return static_cast<size_t>( m_offset / sizeof( CharT ) ) + m_size;
+			}
+
+			// OutputStream Interface
+			inline void operator( )( CharT c ) noexcept {
+				if( m_size == m_capacity ) {
+					write_blocks( );
+				}
+				buffer( )[m_size++] = c;
+			}
+
+			// OutputStream Interface
+			void operator( )( ::daw::io::impl::accept_sized, CharT const *ptr,
+			                  size_t count ) noexcept {
+				while( count > 0 ) {
+					if( m_size == m_capacity ) {
+						write_blocks( );
+					}
+					auto const room = m_capacity - m_size;
+					auto const sz = count < room ? count : room;
+					impl::copy_chars( buffer( ) + m_size, ptr, sz );
+					m_size += sz;
+					ptr += sz;
+					count -= sz;
+				}
+			}
+
+			// OutputStream Interface
+			template<typename String,
+			         std::enable_if_t<( ::daw::impl::is_string_like_v<String> &&
+			                            !::daw::traits::is_character_v<String>),
+			                          std::nullptr_t> = nullptr>
+			inline void operator( )( String &&str ) noexcept {
+				static_assert(
+				  std::is_same_v<remove_cvref_t<CharT>,
+				                 remove_cvref_t<decltype( *str.data( ) )>>,
+				  "String's data( ) character type must match that of output stream" );
+
+				operator( )( ::daw::io::impl::accept_sized{}, str.data( ),
+				             static_cast<size_t>( str.size( ) ) );
+			}
+
+			// Direct formatting into the buffer, nullptr when there is no room after
+			// writing the whole blocks
+			inline CharT *prepare( size_t count ) noexcept {
+				if( count > m_capacity - m_size ) {
+					write_blocks( );
+					if( count > m_capacity - m_size ) {
+						return nullptr;
+					}
+				}
+				return buffer( ) + m_size;
+			}
+
+			inline void commit( size_t count ) noexcept {
+				m_size += count;
+			}
+
+			using mark_t = size_t;
+
+			inline mark_t mark( ) const noexcept {
+				return size( );
+			}
+
+			// Drop what was written after m.  Whole blocks leave the buffer when it
+			// fills or on flush( ), when m is in one of those only the buffer is
+			// dropped, the stream fails and false is returned
+			inline bool rewind( mark_t m ) noexcept {
+				auto const written = static_cast<size_t>( m_offset / sizeof( CharT ) );
+				if( m < written ) {
+					m_size = 0;
+					m_failed = true;
+					return false;
+				}
+				m_size = m - written;
+				return true;
+			}
+
+			// Write the whole blocks that are buffered.  The partial block stays
+			// buffered until it is filled or the stream is closed
+			inline void flush( ) noexcept {
+				write_blocks( );
+			}
+
+			// Write the last partial block padded to a whole one and cut the file
+			// to the size written
+			inline void close( ) noexcept {
+				if( m_fd < 0 ) {
+					return;
+				}
+				write_blocks( );
+				auto const tail = m_size * sizeof( CharT );
+				if( tail > 0 ) {
+					auto *const first = reinterpret_cast<char *>( buffer( ) );
+					std::memset( first + tail, 0, alignment - tail );
+					m_failed |= !impl::pwrite_all( m_fd, first, alignment, m_offset );
+					m_failed |=
+					  ::ftruncate( m_fd, static_cast<off_t>( m_offset + tail ) ) != 0;
+					m_offset += tail;
+					m_size = 0;
+				}
+				::close( std::exchange( m_fd, -1 ) );
+			}
+		};
+
+		template<typename CharT>
+		struct supports_output_stream_interface<direct_file_stream<CharT>>
+		  : std::true_type {};
+	} // namespace io
+
+	template<typename CharT = char>
+	auto make_direct_file_stream(
+	  std::string const &file_name,
+	  io::file_open_flags flags = io::file_open_flags::Write,
+	  size_t buffer_size = io::direct_file_stream<CharT>::default_buffer_size ) {
+
+		return io::direct_file_stream<CharT>( file_name, flags, buffer_size );
+	}
+} // namespace daw
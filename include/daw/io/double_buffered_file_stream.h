@@ -0,0 +1,414 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2019 Darrell Wright
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files( the "Software" ), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and / or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <daw/daw_exception.h>
+#include <daw/daw_string_view.h>
+#include <daw/daw_traits.h>
+
+#include "fd_stream.h"
+#include "file_stream.h"
+#include "ostreams.h"
+
+namespace daw {
+	namespace io {
+		namespace impl {
+			// A ring of buffers written in order by a thread of its own.  Handing
+			// over a buffer is an atomic store, a lock is only taken when a side
+			// has run out of work and is, or is about to, sleep
+			class buffer_writer {
+				int m_fd;
+				size_t m_buffer_size;
+				unsigned m_buffer_count;
+				std::unique_ptr<char[]> m_buffers;
+				std::unique_ptr<size_t[]> m_sizes;
+				// Buffers handed over and buffers written, as running counts
+				std::atomic<size_t> m_submitted{0};
+				std::atomic<size_t> m_written{0};
+				std::atomic<bool> m_writer_waiting{false};
+				std::atomic<bool> m_producer_waiting{false};
+				std::atomic<bool> m_failed{false};
+				bool m_stop = false;
+				std::mutex m_mutex{};
+				std::condition_variable m_submitted_cv{};
+				std::condition_variable m_written_cv{};
+				std::thread m_thread{};
+
+				void run( ) noexcept {
+					size_t n = 0;
+					while( true ) {
+						if( m_submitted.load( std::memory_order_acquire ) == n ) {
+							std::unique_lock<std::mutex> lock( m_mutex );
+							m_writer_waiting.store( true );
+							m_submitted_cv.wait(
+							  lock, [&] { return m_submitted.load( ) != n || m_stop; } );
+							m_writer_waiting.store( false );
+							if( m_submitted.load( ) == n ) {
+								return;
+							}
+						}
+						auto const bytes = m_sizes[n % m_buffer_count];
+						if( !write_all( m_fd, buffer( n % m_buffer_count ), bytes ) ) {
+							m_failed.store( true, std::memory_order_relaxed );
+						}
+						m_written.store( ++n );
+						if( m_producer_waiting.load( ) ) {
+							std::lock_guard<std::mutex> lock( m_mutex );
+							m_written_cv.notify_one( );
+						}
+					}
+				}
+
+			public:
+				buffer_writer( int fd, size_t buffer_size, unsigned buffer_count )
+				  : m_fd( fd )
+				  , m_buffer_size( buffer_size )
+				  , m_buffer_count( buffer_count )
+				  , m_buffers( new char[buffer_size * buffer_count] )
+				  , m_sizes( new size_t[buffer_count] ) {
+
+					m_thread = std::thread( [this] { run( ); } );
+				}
+
+				buffer_writer( buffer_writer const & ) = delete;
+				buffer_writer &operator=( buffer_writer const & ) = delete;
+
+				// Everything submitted is written first
+				~buffer_writer( ) {
+					{
+						std::lock_guard<std::mutex> lock( m_mutex );
+						m_stop = true;
+					}
+					m_submitted_cv.notify_one( );
+					m_thread.join( );
+				}
+
+				char *buffer( size_t index ) const noexcept {
+					return m_buffers.get( ) + index * m_buffer_size;
+				}
+
+				// The first buffer to fill
+				char *first( ) const noexcept {
+					return buffer( 0 );
+				}
+
+				bool failed( ) const noexcept {
+					return m_failed.load( std::memory_order_relaxed );
+				}
+
+				// Wait until count buffers have been written
+				void wait_written( size_t count ) {
+					if( m_written.load( std::memory_order_acquire ) >= count ) {
+						return;
+					}
+					std::unique_lock<std::mutex> lock( m_mutex );
+					m_producer_waiting.store( true );
+					m_written_cv.wait( lock, [&] { return m_written.load( ) >= count; } );
+					m_producer_waiting.store( false );
+				}
+
+				void wait_all( ) {
+					wait_written( m_submitted.load( std::memory_order_relaxed ) );
+				}
+
+				// Hand the buffer being filled, bytes long, to the writer and return
+				// the next one once it is free
+				char *submit( size_t bytes ) {
+					auto const n = m_submitted.load( std::memory_order_relaxed );
+					m_sizes[n % m_buffer_count] = bytes;
+					m_submitted.store( n + 1U );
+					if( m_writer_waiting.load( ) ) {
+						std::lock_guard<std::mutex> lock( m_mutex );
+						m_submitted_cv.notify_one( );
+					}
+					// Free when the buffer submitted m_buffer_count ago is written
+					if( n + 2U > m_buffer_count ) {
+						wait_written( n + 2U - m_buffer_count );
+					}
+					return buffer( ( n + 1U ) % m_buffer_count );
+				}
+			};
+		} // namespace impl
+
+		// Output to a file descriptor where the calling thread only formats.  Full
+		// buffers are handed to a thread that writes them with write(2) while the
+		// next is filled.  The calling thread waits when all buffer_count buffers
+		// are waiting to be written
+		template<typename CharT = char>
+		class double_buffered_file_stream {
+			int m_fd = -1;
+			bool m_is_owner = true;
+			bool m_failed = false;
+			size_t m_capacity;
+			std::unique_ptr<impl::buffer_writer> m_writer;
+			CharT *m_buffer;
+			size_t m_size = 0;
+			// Characters handed to the writer so far
+			size_t m_submitted = 0;
+
+			void submit( ) {
+				if( m_size == 0 ) {
+					return;
+				}
+				m_buffer = reinterpret_cast<CharT *>(
+				  m_writer->submit( m_size * sizeof( CharT ) ) );
+				m_submitted += m_size;
+				m_size = 0;
+			}
+
+			// Close or, when not the owner, flush.  Waiting on the writer thread can
+			// throw std::system_error and there is nowhere to report it from a
+			// destructor, so the file is closed regardless
+			void finish( ) noexcept {
+				try {
+					if( m_is_owner ) {
+						close( );
+					} else {
+						flush( );
+					}
+				} catch( ... ) {
+					m_failed = true;
+					m_writer.reset( );
+					if( m_is_owner && m_fd >= 0 ) {
+						::close( std::exchange( m_fd, -1 ) );
+					}
+				}
+			}
+
+		public:
+			// OutputStream Interface
+			using character_t = CharT;
+
+			static constexpr size_t const default_buffer_size = 256U * 1024U;
+			static constexpr unsigned const default_buffer_count = 2U;
+
+			explicit double_buffered_file_stream(
+			  int fd, bool take_ownership, size_t buffer_size = default_buffer_size,
+			  unsigned buffer_count = default_buffer_count )
+			  : m_fd( fd )
+			  , m_is_owner( take_ownership )
+			  , m_capacity( buffer_size > 0 ? buffer_size : 1U )
+			  , m_writer( std::make_unique<impl::buffer_writer>(
+			      fd, m_capacity * sizeof( CharT ),
+			      buffer_count > 1U ? buffer_count : 2U ) )
+			  , m_buffer( reinterpret_cast<CharT *>( m_writer->first( ) ) ) {}
+
+			explicit double_buffered_file_stream(
+			  std::string const &file_name,
+			  file_open_flags flags = file_open_flags::Write,
+			  size_t buffer_size = default_buffer_size,
+			  unsigned buffer_count = default_buffer_count )
+			  : double_buffered_file_stream( impl::open_file( file_name, flags ),
+			                                 true, buffer_size, buffer_count ) {}
+
+			double_buffered_file_stream( double_buffered_file_stream &&other ) noexcept
+			  : m_fd( std::exchange( other.m_fd, -1 ) )
+			  , m_is_owner( std::exchange( other.m_is_owner, false ) )
+			  , m_failed( other.m_failed )
+			  , m_capacity( other.m_capacity )
+			  , m_writer( std::move( other.m_writer ) )
+			  , m_buffer( other.m_buffer )
+			  , m_size( std::exchange( other.m_size, 0 ) )
+			  , m_submitted( other.m_submitted ) {}
+
+			double_buffered_file_stream &
+			operator=( double_buffered_file_stream &&rhs ) noexcept {
+				if( this != &rhs ) {
+					finish( );
+					m_fd = std::exchange( rhs.m_fd, -1 );
+					m_is_owner = std::exchange( rhs.m_is_owner, false );
+					m_failed = rhs.m_failed;
+					m_capacity = rhs.m_capacity;
+					m_writer = std::move( rhs.m_writer );
+					m_buffer = rhs.m_buffer;
+					m_size = std::exchange( rhs.m_size, 0 );
+					m_submitted = rhs.m_submitted;
+				}
+				return *this;
+			}
+
+			double_buffered_file_stream( double_buffered_file_stream const & ) =
+			  delete;
+			double_buffered_file_stream &
+			operator=( double_buffered_file_stream const & ) = delete;
+
+			~double_buffered_file_stream( ) {
+				finish( );
+			}
+
+			// False when the file is not open or a write has failed
+			inline explicit operator bool( ) const noexcept {
+				return m_fd >= 0 && !m_failed && m_writer && !m_writer->failed( );
+			}
+
+			inline int native_handle( ) const noexcept {
+				return m_fd;
+			}
+
+			// Characters written, including those not yet submitted
+			inline size_t size( ) const noexcept {
+				return m_submitted + m_size;
+			}
+
+			// OutputStream Interface
+			inline void operator( )( CharT c ) {
+				if( m_size == m_capacity ) {
+					submit( );
+				}
+				m_buffer[m_size++] = c;
+			}
+
+			// OutputStream Interface
+			void operator( )( ::daw::io::impl::accept_sized, CharT const *ptr,
+			                  size_t count ) {
+				while( count > 0 ) {
+					if( m_size == m_capacity ) {
+						submit( );
+					}
+					auto const room = m_capacity - m_size;
+					auto const sz = count < room ? count : room;
+					impl::copy_chars( m_buffer + m_size, ptr, sz );
+					m_size += sz;
+					ptr += sz;
+					count -= sz;
+				}
+			}
+
+			// OutputStream Interface
+			template<typename String,
+			         std::enable_if_t<( ::daw::impl::is_string_like_v<String> &&
+			                            !::daw::traits::is_character_v<String>),
+			                          std::nullptr_t> = nullptr>
+			inline void operator( )( String &&str ) {
+				static_assert(
+				  std::is_same_v<remove_cvref_t<CharT>,
+				                 remove_cvref_t<decltype( *str.data( ) )>>,
+				  "String's data( ) character type must match that of output stream" );
+
+				operator( )( ::daw::io::impl::accept_sized{}, str.data( ),
+				             static_cast<size_t>( str.size( ) ) );
+			}
+
+			// Direct formatting into the current buffer, nullptr when count is
+			// larger than a buffer
+			inline CharT *prepare( size_t count ) {
+				if( count > m_capacity ) {
+					return nullptr;
+				}
+				if( count > m_capacity - m_size ) {
+					submit( );
+				}
+				return m_buffer + m_size;
+			}
+
+			inline void commit( size_t count ) noexcept {
+				m_size += count;
+			}
+
+			using mark_t = size_t;
+
+			inline mark_t mark( ) const noexcept {
+				return size( );
+			}
+
+			// Drop what was written after m.  A buffer belongs to the writer thread
+			// once handed over, when m is from before the one being filled only it
+			// is dropped, the stream fails and false is returned
+			inline bool rewind( mark_t m ) noexcept {
+				if( m < m_submitted ) {
+					m_size = 0;
+					m_failed = true;
+					return false;
+				}
+				m_size = m - m_submitted;
+				return true;
+			}
+
+			// Submit the current buffer and wait until everything is written.  With
+			// durable, also wait until the data is on the storage device
+			void flush( bool durable = false ) {
+				if( !m_writer ) {
+					return;
+				}
+				submit( );
+				m_writer->wait_all( );
+				if( durable && m_fd >= 0 ) {
+#if defined( __APPLE__ )
+					m_failed |= ::fsync( m_fd ) != 0;
+#else
+					m_failed |= ::fdatasync( m_fd ) != 0;
+#endif
+				}
+			}
+
+			void close( ) {
+				flush( );
+				m_writer.reset( );
+				if( m_fd >= 0 ) {
+					::close( std::exchange( m_fd, -1 ) );
+				}
+			}
+		};
+
+		template<typename CharT>
+		struct supports_output_stream_interface<double_buffered_file_stream<CharT>>
+		  : std::true_type {};
+	} // namespace io
+
+	template<typename CharT = char>
+	auto make_double_buffered_file_stream(
+	  std::string const &file_name,
+	  io::file_open_flags flags = io::file_open_flags::Write,
+	  size_t buffer_size =
+	    io::double_buffered_file_stream<CharT>::default_buffer_size,
+	  unsigned buffer_count =
+	    io::double_buffered_file_stream<CharT>::default_buffer_count ) {
+
+		return io::double_buffered_file_stream<CharT>( file_name, flags,
+		                                               buffer_size, buffer_count );
+	}
+
+	template<typename CharT = char>
+	auto make_double_buffered_file_stream(
+	  int fd, bool take_ownership = false,
+	  size_t buffer_size =
+	    io::double_buffered_file_stream<CharT>::default_buffer_size,
+	  unsigned buffer_count =
+	    io::double_buffered_file_stream<CharT>::default_buffer_count ) {
+
+		return io::double_buffered_file_stream<CharT>( fd, take_ownership,
+		                                               buffer_size, buffer_count );
+	}
+} // namespace daw
@@ -0,0 +1,314 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2019 Darrell Wright
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files( the "Software" ), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and / or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <daw/daw_exception.h>
+#include <daw/daw_string_view.h>
+#include <daw/daw_traits.h>
+
+#include "file_stream.h"
+#include "ostreams.h"
+
+namespace daw {
+	namespace io {
+		namespace impl {
+			// Write all of size bytes at offset, resuming after partial writes
+			inline bool pwrite_all( int fd, char const *data, size_t size,
+			                        uint64_t offset ) noexcept {
+				while( size > 0 ) {
+					auto const result =
+					  ::pwrite( fd, data, size, static_cast<off_t>( offset ) );
+					if( result < 0 ) {
+						if( errno == EINTR ) {
+							continue;
+						}
+						return false;
+					}
+					data += result;
+					size -= static_cast<size_t>( result );
+					offset += static_cast<uint64_t>( result );
+				}
+				return true;
+			}
+
+			// Write all of iovs, resuming after partial writes and signals
+			inline bool write_all( int fd, ::iovec *iovs, int count ) noexcept {
+				while( count > 0 ) {
+					auto result = ::writev( fd, iovs, count );
+					if( result < 0 ) {
+						if( errno == EINTR ) {
+							continue;
+						}
+						return false;
+					}
+					auto written = static_cast<size_t>( result );
+					while( count > 0 && written >= iovs->iov_len ) {
+						written -= iovs->iov_len;
+						++iovs;
+						--count;
+					}
+					if( count > 0 ) {
+						iovs->iov_base = static_cast<char *>( iovs->iov_base ) + written;
+						iovs->iov_len -= written;
+					}
+				}
+				return true;
+			}
+
+			inline bool write_all( int fd, void const *ptr, size_t size ) noexcept {
+				::iovec iov{const_cast<void *>( ptr ), size};
+				return write_all( fd, &iov, 1 );
+			}
+
+			inline int open_file( std::string const &file_name,
+			                      file_open_flags flags, int extra_flags = 0 ) {
+				return ::open( file_name.c_str( ),
+				               O_WRONLY | O_CREAT | O_CLOEXEC | extra_flags |
+				                 ( flags == file_open_flags::Write ? O_TRUNC : O_APPEND ),
+				               0666 );
+			}
+		} // namespace impl
+
+		// Buffered output to a POSIX file descriptor.  Unlike file_stream there
+		// is no FILE lock per character, output is gathered in a buffer of
+		// buffer_size characters and written with write(2)/writev(2).  Characters
+		// are written as is, without the conversion a wide FILE does.  A stream
+		// is used from one thread at a time
+		template<typename CharT = char>
+		class fd_stream {
+			int m_fd = -1;
+			bool m_is_owner = true;
+			bool m_failed = false;
+			std::unique_ptr<CharT[]> m_buffer;
+			size_t m_capacity;
+			size_t m_size = 0;
+			// Characters written to the file so far
+			size_t m_written = 0;
+
+			// The buffer and ptr in one system call
+			void write_through( CharT const *ptr, size_t count ) noexcept {
+				::iovec iovs[2] = {
+				  {static_cast<void *>( m_buffer.get( ) ), m_size * sizeof( CharT )},
+				  {const_cast<CharT *>( ptr ), count * sizeof( CharT )}};
+				m_failed |= !impl::write_all( m_fd, iovs, 2 );
+				m_written += m_size + count;
+				m_size = 0;
+			}
+
+		public:
+			// OutputStream Interface
+			using character_t = CharT;
+
+			static constexpr size_t const default_buffer_size = 64U * 1024U;
+
+			explicit fd_stream( int fd, bool take_ownership,
+			                    size_t buffer_size = default_buffer_size )
+			  : m_fd( fd )
+			  , m_is_owner( take_ownership )
+			  , m_buffer( new CharT[buffer_size > 0 ? buffer_size : 1U] )
+			  , m_capacity( buffer_size > 0 ? buffer_size : 1U ) {}
+
+			explicit fd_stream( std::string const &file_name,
+			                    file_open_flags flags = file_open_flags::Write,
+			                    size_t buffer_size = default_buffer_size )
+			  : fd_stream( impl::open_file( file_name, flags ), true,
+			               buffer_size ) {}
+
+			fd_stream( fd_stream &&other ) noexcept
+			  : m_fd( std::exchange( other.m_fd, -1 ) )
+			  , m_is_owner( std::exchange( other.m_is_owner, false ) )
+			  , m_failed( other.m_failed )
+			  , m_buffer( std::move( other.m_buffer ) )
+			  , m_capacity( std::exchange( other.m_capacity, 0 ) )
+			  , m_size( std::exchange( other.m_size, 0 ) )
+			  , m_written( other.m_written ) {}
+
+			fd_stream &operator=( fd_stream &&rhs ) noexcept {
+				if( this != &rhs ) {
+					if( m_is_owner ) {
+						close( );
+					} else {
+						flush( );
+					}
+					m_fd = std::exchange( rhs.m_fd, -1 );
+					m_is_owner = std::exchange( rhs.m_is_owner, false );
+					m_failed = rhs.m_failed;
+					m_buffer = std::move( rhs.m_buffer );
+					m_capacity = std::exchange( rhs.m_capacity, 0 );
+					m_size = std::exchange( rhs.m_size, 0 );
+					m_written = rhs.m_written;
+				}
+				return *this;
+			}
+
+			fd_stream( fd_stream const & ) = delete;
+			fd_stream &operator=( fd_stream const & ) = delete;
+
+			~fd_stream( ) {
+				if( m_is_owner ) {
+					close( );
+				} else {
+					flush( );
+				}
+			}
+
+			// False when the descriptor is not open or a write has failed
+			inline explicit operator bool( ) const noexcept {
+				return m_fd >= 0 && !m_failed;
+			}
+
+			inline int native_handle( ) const noexcept {
+				return m_fd;
+			}
+
+			// Characters written, including those still in the buffer
+			inline size_t size( ) const noexcept {
+				return m_written + m_size;
+			}
+
+			// OutputStream Interface
+			inline void operator( )( CharT c ) noexcept {
+				if( m_size == m_capacity ) {
+					flush( );
+				}
+				m_buffer[m_size++] = c;
+			}
+
+			// OutputStream Interface
+			inline void operator( )( ::daw::io::impl::accept_sized, CharT const *ptr,
+			                         size_t count ) noexcept {
+				if( count <= m_capacity - m_size ) {
+					impl::copy_chars( m_buffer.get( ) + m_size, ptr, count );
+					m_size += count;
+					return;
+				}
+				if( count >= m_capacity ) {
+					// Not worth copying, write it out along with the buffer
+					write_through( ptr, count );
+					return;
+				}
+				flush( );
+				impl::copy_chars( m_buffer.get( ), ptr, count );
+				m_size = count;
+			}
+
+			// OutputStream Interface
+			template<typename String,
+			         std::enable_if_t<( ::daw::impl::is_string_like_v<String> &&
+			                            !::daw::traits::is_character_v<String>),
+			                          std::nullptr_t> = nullptr>
+			inline void operator( )( String &&str ) noexcept {
+				static_assert(
+				  std::is_same_v<remove_cvref_t<CharT>,
+				                 remove_cvref_t<decltype( *str.data( ) )>>,
+				  "String's data( ) character type must match that of output stream" );
+
+				operator( )( ::daw::io::impl::accept_sized{}, str.data( ),
+				             static_cast<size_t>( str.size( ) ) );
+			}
+
+			// Direct formatting into the buffer, nullptr when count is larger than
+			// the buffer
+			inline CharT *prepare( size_t count ) noexcept {
+				if( count > m_capacity ) {
+					return nullptr;
+				}
+				if( count > m_capacity - m_size ) {
+					flush( );
+				}
+				return m_buffer.get( ) + m_size;
+			}
+
+			inline void commit( size_t count ) noexcept {
+				m_size += count;
+			}
+
+			using mark_t = size_t;
+
+			inline mark_t mark( ) const noexcept {
+				return size( );
+			}
+
+			// Drop what was written after m.  Output already passed to write( )
+			// cannot be taken back, when m is from before the last flush only the
+			// buffer is dropped, the stream fails and false is returned
+			inline bool rewind( mark_t m ) noexcept {
+				if( m < m_written ) {
+					m_size = 0;
+					m_failed = true;
+					return false;
+				}
+				m_size = m - m_written;
+				return true;
+			}
+
+			inline void flush( ) noexcept {
+				if( m_size > 0 && m_fd >= 0 ) {
+					m_failed |=
+					  !impl::write_all( m_fd, m_buffer.get( ), m_size * sizeof( CharT ) );
+					m_written += m_size;
+				}
+				m_size = 0;
+			}
+
+			inline void close( ) noexcept {
+				flush( );
+				if( m_fd >= 0 ) {
+					::close( std::exchange( m_fd, -1 ) );
+				}
+			}
+		};
+
+		template<typename CharT>
+		struct supports_output_stream_interface<fd_stream<CharT>>
+		  : std::true_type {};
+	} // namespace io
+
+	template<typename CharT = char>
+	auto make_fd_stream(
+	  std::string const &file_name,
+	  io::file_open_flags flags = io::file_open_flags::Write,
+	  size_t buffer_size = io::fd_stream<CharT>::default_buffer_size ) {
+
+		return io::fd_stream<CharT>( file_name, flags, buffer_size );
+	}
+
+	template<typename CharT = char>
+	auto make_fd_stream(
+	  int fd, bool take_ownership = false,
+	  size_t buffer_size = io::fd_stream<CharT>::default_buffer_size ) {
+
+		return io::fd_stream<CharT>( fd, take_ownership, buffer_size );
+	}
+} // namespace daw
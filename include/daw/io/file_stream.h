@@ -23,6 +23,7 @@
 #pragma once
 
 #include <cstdio>
+#include <cstring>
 #include <cwchar>
 #include <string>
 
@@ -35,7 +36,32 @@ namespace daw {
 	namespace io {
 		enum class file_open_flags : bool { Write, Append };
 
+		// locked takes the FILE's lock for every write, as stdio does.  unlocked
+		// never takes it and is for a FILE used by one thread only
+		enum class locking_policy : bool { locked, unlocked };
+
 		namespace impl {
+			inline void lock_file( FILE *f ) noexcept {
+#if defined( _WIN32 )
+				_lock_file( f );
+#elif defined( __unix__ ) || defined( __APPLE__ )
+				flockfile( f );
+#else
+				(void)f;
+#endif
+			}
+
+			inline void unlock_file( FILE *f ) noexcept {
+#if defined( _WIN32 )
+				_unlock_file( f );
+#elif defined( __unix__ ) || defined( __APPLE__ )
+				funlockfile( f );
+#else
+				(void)f;
+#endif
+			}
+
+			template<locking_policy Locking = locking_policy::locked>
 			struct write_char {
 				constexpr write_char( ) noexcept = default;
 
@@ -55,17 +81,149 @@ namespace daw {
 					return fputws( ptr, f );
 				}
 
-				template<typename CharT,
-				         std::enable_if_t<daw::traits::is_character_v<CharT>,
-				                          std::nullptr_t> = nullptr>
-				inline auto operator( )( CharT const *ptr, size_t len, FILE *f ) const
+				inline auto operator( )( char const *ptr, size_t len, FILE *f ) const
+				  noexcept {
+					return fwrite( ptr, sizeof( char ), len, f );
+				}
+
+				// Wide characters go through the FILE's conversion
+				inline auto operator( )( wchar_t const *ptr, size_t len, FILE *f ) const
 				  noexcept {
-					return fwrite( ptr, sizeof( CharT ), len, f );
+					size_t n = 0;
+					while( n < len && putwc( ptr[n], f ) != WEOF ) {
+						++n;
+					}
+					return n;
+				}
+			};
+
+			// The caller either holds the lock or is the only user of the FILE
+			template<>
+			struct write_char<locking_policy::unlocked> {
+				constexpr write_char( ) noexcept = default;
+
+				inline auto operator( )( char c, FILE *f ) const noexcept {
+#if defined( _WIN32 )
+					return _putc_nolock( c, f );
+#elif defined( __unix__ ) || defined( __APPLE__ )
+					return putc_unlocked( c, f );
+#else
+					return putc( c, f );
+#endif
+				}
+
+				inline auto operator( )( wchar_t c, FILE *f ) const noexcept {
+#if defined( _WIN32 )
+					return _putwc_nolock( c, f );
+#elif defined( __GLIBC__ )
+					return putwc_unlocked( c, f );
+#else
+					return putwc( c, f );
+#endif
+				}
+
+				inline auto operator( )( char const *ptr, size_t len, FILE *f ) const
+				  noexcept {
+#if defined( _WIN32 )
+					return _fwrite_nolock( ptr, sizeof( char ), len, f );
+#elif defined( __GLIBC__ )
+					return fwrite_unlocked( ptr, sizeof( char ), len, f );
+#elif defined( __unix__ ) || defined( __APPLE__ )
+					size_t n = 0;
+					while( n < len && putc_unlocked( ptr[n], f ) != EOF ) {
+						++n;
+					}
+					return n;
+#else
+					return fwrite( ptr, sizeof( char ), len, f );
+#endif
+				}
+
+				inline auto operator( )( wchar_t const *ptr, size_t len, FILE *f ) const
+				  noexcept {
+					size_t n = 0;
+					while( n < len && operator( )( ptr[n], f ) != WEOF ) {
+						++n;
+					}
+					return n;
+				}
+
+				inline auto operator( )( char const *ptr, FILE *f ) const noexcept {
+					return operator( )( ptr, std::strlen( ptr ), f );
+				}
+
+				inline auto operator( )( wchar_t const *ptr, FILE *f ) const noexcept {
+					return operator( )( ptr, std::wcslen( ptr ), f );
 				}
 			};
 		} // namespace impl
 
+		// Holds the FILE's lock from construction to destruction and writes
+		// without taking it again.  Returned by locked( ) on the file and console
+		// streams so that a whole statement takes the lock once,
+		// daw::con_out.locked( ) << "The answer is " << 42 << '\n';
 		template<typename CharT>
+		class locked_file_stream {
+			FILE *m_file_handle;
+
+		public:
+			// OutputStream Interface
+			using character_t = CharT;
+
+			inline explicit locked_file_stream( FILE *f ) noexcept
+			  : m_file_handle( f ) {
+				impl::lock_file( m_file_handle );
+			}
+
+			inline ~locked_file_stream( ) {
+				impl::unlock_file( m_file_handle );
+			}
+
+			locked_file_stream( locked_file_stream const & ) = delete;
+			locked_file_stream &operator=( locked_file_stream const & ) = delete;
+
+			// OutputStream Interface
+			inline auto operator( )( CharT c ) const noexcept {
+				return impl::write_char<locking_policy::unlocked>{}( c,
+				                                                     m_file_handle );
+			}
+
+			// OutputStream Interface
+			inline auto operator( )( daw::io::impl::accept_asciiz,
+			                         CharT const *ptr ) const noexcept {
+				return impl::write_char<locking_policy::unlocked>{}( ptr,
+				                                                     m_file_handle );
+			}
+
+			// OutputStream Interface
+			inline auto operator( )( daw::io::impl::accept_sized, CharT const *ptr,
+			                         size_t count ) const noexcept {
+				return impl::write_char<locking_policy::unlocked>{}( ptr, count,
+				                                                     m_file_handle );
+			}
+
+			// OutputStream Interface
+			template<typename String,
+			         std::enable_if_t<( ::daw::impl::is_string_like_v<String> &&
+			                            !::daw::traits::is_character_v<String>),
+			                          std::nullptr_t> = nullptr>
+			inline void operator( )( String &&str ) const noexcept {
+				static_assert(
+				  std::is_same_v<remove_cvref_t<CharT>,
+				                 remove_cvref_t<decltype( *str.data( ) )>>,
+				  "String's data( ) character type must match that of output stream" );
+
+				impl::write_char<locking_policy::unlocked>{}(
+				  str.data( ), static_cast<size_t>( str.size( ) ), m_file_handle );
+			}
+		};
+
+		template<typename CharT>
+		struct supports_output_stream_interface<locked_file_stream<CharT>>
+		  : std::true_type {};
+
+		template<typename CharT,
+		         locking_policy Locking = locking_policy::locked>
 		class file_stream {
 			FILE *m_file_handle;
 			bool m_is_owner = true;
@@ -86,12 +244,18 @@ namespace daw {
 
 			// OutputStream Interface
 			inline auto operator( )( CharT c ) const noexcept {
-				return impl::write_char{}( c, m_file_handle );
+				return impl::write_char<Locking>{}( c, m_file_handle );
 			}
 
 			inline auto operator( )( daw::io::impl::accept_asciiz,
 			                         CharT const *ptr ) const noexcept {
-				return impl::write_char{}( ptr, m_file_handle );
+				return impl::write_char<Locking>{}( ptr, m_file_handle );
+			}
+
+			// OutputStream Interface
+			inline auto operator( )( daw::io::impl::accept_sized, CharT const *ptr,
+			                         size_t count ) const noexcept {
+				return impl::write_char<Locking>{}( ptr, count, m_file_handle );
 			}
 
 			// OutputStream Interface
@@ -105,7 +269,7 @@ namespace daw {
 				                 remove_cvref_t<decltype( *str.data( ) )>>,
 				  "String's data( ) character type must match that of output stream" );
 
-				impl::write_char{}( str.data( ), str.size( ), m_file_handle );
+				impl::write_char<Locking>{}( str.data( ), str.size( ), m_file_handle );
 			}
 
 			inline explicit operator bool( ) const noexcept {
@@ -116,6 +280,11 @@ namespace daw {
 				return m_file_handle;
 			}
 
+			// Hold the lock for the rest of the statement, fs.locked( ) << a << b;
+			inline locked_file_stream<CharT> locked( ) const noexcept {
+				return locked_file_stream<CharT>( m_file_handle );
+			}
+
 			inline void flush( ) noexcept {
 				fflush( m_file_handle );
 			}
@@ -153,8 +322,8 @@ namespace daw {
 			file_stream &operator=( file_stream const & ) = delete;
 		};
 
-		template<typename CharT>
-		struct supports_output_stream_interface<file_stream<CharT>>
+		template<typename CharT, locking_policy Locking>
+		struct supports_output_stream_interface<file_stream<CharT, Locking>>
 		  : std::true_type {};
 	} // namespace io
 
@@ -192,4 +361,22 @@ namespace daw {
 
 		return io::file_stream<CharT>( fp, take_ownership );
 	}
+
+	template<io::locking_policy Locking, typename CharT,
+	         std::enable_if_t<(std::is_same_v<char, remove_cvref_t<CharT>> ||
+	                           std::is_same_v<wchar_t, remove_cvref_t<CharT>>),
+	                          std::nullptr_t> = nullptr>
+	auto make_file_stream(
+	  CharT const *file_name,
+	  io::file_open_flags flags = io::file_open_flags::Write ) noexcept {
+
+		return io::file_stream<CharT, Locking>(
+		  std::basic_string<CharT>( file_name ), flags );
+	}
+
+	template<io::locking_policy Locking, typename CharT = char>
+	inline auto make_file_stream( FILE *fp, bool take_ownership = false ) {
+
+		return io::file_stream<CharT, Locking>( fp, take_ownership );
+	}
 } // namespace daw
@@ -0,0 +1,241 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2019 Darrell Wright
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files( the "Software" ), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and / or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+#include <daw/daw_traits.h>
+
+#include "ostreams.h"
+
+// A format string for daw::io::format, "value={} at {}\n" style.  Each {} is
+// replaced by the next argument, {{ and }} are literal braces.  The string is
+// parsed when compiling
+#define DAW_IO_FMT( str )                                                      \
+	[] {                                                                         \
+		struct daw_io_format_string {                                              \
+			static constexpr decltype( auto ) get( ) noexcept {                      \
+				return ( str );                                                        \
+			}                                                                        \
+		};                                                                         \
+		return daw_io_format_string{};                                             \
+	}( )
+
+namespace daw {
+	namespace io {
+		namespace impl {
+			// Not constexpr, so calling it while parsing a format string fails to
+			// compile with its name in the error
+			inline void unmatched_brace_in_format_string( ) {}
+
+			template<typename CharT, size_t N>
+			constexpr size_t count_format_holes( CharT const ( &str )[N] ) {
+				size_t holes = 0;
+				for( size_t n = 0; n + 1 < N; ++n ) {
+					if( str[n] == static_cast<CharT>( '{' ) ) {
+						if( n + 2 < N && str[n + 1] == static_cast<CharT>( '}' ) ) {
+							++holes;
+						} else if( !( n + 2 < N &&
+						              str[n + 1] == static_cast<CharT>( '{' ) ) ) {
+							unmatched_brace_in_format_string( );
+						}
+						++n;
+					} else if( str[n] == static_cast<CharT>( '}' ) ) {
+						if( !( n + 2 < N && str[n + 1] == static_cast<CharT>( '}' ) ) ) {
+							unmatched_brace_in_format_string( );
+						}
+						++n;
+					}
+				}
+				return holes;
+			}
+
+			// The literal text of a format string with escapes resolved, split in
+			// Holes + 1 segments around the holes
+			template<typename CharT, size_t N, size_t Holes>
+			struct parsed_format_t {
+				CharT text[N]{};
+				size_t text_size = 0;
+				size_t segment_first[Holes + 1]{};
+				size_t segment_size[Holes + 1]{};
+			};
+
+			template<size_t Holes, typename CharT, size_t N>
+			constexpr parsed_format_t<CharT, N, Holes>
+			parse_format( CharT const ( &str )[N] ) {
+				parsed_format_t<CharT, N, Holes> result{};
+				size_t segment = 0;
+				for( size_t n = 0; n + 1 < N; ++n ) {
+					if( str[n] == static_cast<CharT>( '{' ) &&
+					    str[n + 1] == static_cast<CharT>( '}' ) ) {
+						result.segment_size[segment] =
+						  result.text_size - result.segment_first[segment];
+						++segment;
+						result.segment_first[segment] = result.text_size;
+						++n;
+						continue;
+					}
+					if( str[n] == static_cast<CharT>( '{' ) ||
+					    str[n] == static_cast<CharT>( '}' ) ) {
+						// The second of {{ or }}
+						++n;
+					}
+					result.text[result.text_size++] = str[n];
+				}
+				result.segment_size[segment] =
+				  result.text_size - result.segment_first[segment];
+				return result;
+			}
+
+			template<typename Format>
+			using format_string_t =
+			  std::remove_reference_t<decltype( Format::get( ) )>;
+
+			template<typename Format>
+			using format_char_t =
+			  remove_cvref_t<std::remove_extent_t<format_string_t<Format>>>;
+
+			template<typename Format>
+			inline constexpr size_t const format_holes_v =
+			  count_format_holes( Format::get( ) );
+
+			template<typename Format>
+			inline constexpr auto const parsed_format_v =
+			  parse_format<format_holes_v<Format>>( Format::get( ) );
+
+			template<typename Format>
+			using is_format_string_detect = decltype( Format::get( ) );
+
+			template<typename Format>
+			constexpr bool is_format_string_v( ) noexcept {
+				if constexpr( daw::is_detected_v<is_format_string_detect, Format> ) {
+					return std::is_array_v<format_string_t<Format>>;
+				} else {
+					return false;
+				}
+			}
+
+			template<typename Format, size_t I, typename CharT>
+			constexpr CharT *copy_segment( CharT *first ) noexcept {
+				constexpr auto const &fmt = parsed_format_v<Format>;
+				if constexpr( fmt.segment_size[I] > 0 ) {
+					copy_chars( first, fmt.text + fmt.segment_first[I],
+					            fmt.segment_size[I] );
+				}
+				return first + fmt.segment_size[I];
+			}
+
+			template<typename Format, size_t I, typename OutputStream>
+			constexpr void write_segment( OutputStream &os ) {
+				constexpr auto const &fmt = parsed_format_v<Format>;
+				if constexpr( fmt.segment_size[I] > 0 ) {
+					write_chars( os, fmt.text + fmt.segment_first[I],
+					             fmt.segment_size[I] );
+				}
+			}
+
+			template<typename Format, typename OutputStream, size_t... Is,
+			         typename... Args>
+			constexpr OutputStream &format( OutputStream &os,
+			                                std::index_sequence<Is...>,
+			                                Args const &... args ) {
+				using CharT = typename remove_cvref_t<OutputStream>::character_t;
+				if constexpr( all_true_v<
+				                has_prepare_commit_v<OutputStream>,
+				                !has_operator_parans_length_v<OutputStream>,
+				                is_batch_writable_v<CharT, Args>...> ) {
+					// One capacity check for the whole string
+					size_t const bound = parsed_format_v<Format>.text_size +
+					                     ( write_bound<CharT>( args ) + ... + 0U );
+					if( CharT *const first = os.prepare( bound ); first != nullptr ) {
+						CharT *last = copy_segment<Format, 0>( first );
+						( ( last = copy_segment<Format, Is + 1>(
+						      write_one( last, args ) ) ),
+						  ... );
+						os.commit( static_cast<size_t>( last - first ) );
+						return os;
+					}
+				}
+				write_segment<Format, 0>( os );
+				( ( os << args, write_segment<Format, Is + 1>( os ) ), ... );
+				return os;
+			}
+		} // namespace impl
+
+		// Write args in the places of the {}'s in the format string made with
+		// DAW_IO_FMT.  There is no parsing at runtime, the literal text is
+		// copied in blocks and the arguments formatted in between
+		template<typename OutputStream, typename Format, typename... Args,
+		         std::enable_if_t<all_true_v<is_output_stream_v<OutputStream>,
+		                                     impl::is_format_string_v<Format>( )>,
+		                          std::nullptr_t> = nullptr>
+		constexpr OutputStream &format( OutputStream &os, Format,
+		                                Args const &... args ) {
+			static_assert(
+			  std::is_same_v<typename remove_cvref_t<OutputStream>::character_t,
+			                 impl::format_char_t<Format>>,
+			  "Character type in OutputStream does not match that of the format "
+			  "string" );
+			static_assert( impl::format_holes_v<Format> == sizeof...( Args ),
+			               "The number of {}'s in the format string must match the "
+			               "number of arguments" );
+			return impl::format<Format>(
+			  os, std::make_index_sequence<sizeof...( Args )>{}, args... );
+		}
+
+#if defined( __cpp_nontype_template_args ) &&                                 \
+  __cpp_nontype_template_args >= 201911L
+		namespace impl {
+			template<typename CharT, size_t N>
+			struct fixed_format_string {
+				CharT value[N]{};
+
+				constexpr fixed_format_string( CharT const ( &str )[N] ) noexcept {
+					for( size_t n = 0; n < N; ++n ) {
+						value[n] = str[n];
+					}
+				}
+			};
+
+			template<fixed_format_string Str>
+			struct fixed_format {
+				static constexpr auto const &get( ) noexcept {
+					return Str.value;
+				}
+			};
+		} // namespace impl
+
+		// format<"value={} at {}\n">( os, a, b ) when the compiler allows string
+		// literals as template arguments
+		template<impl::fixed_format_string Str, typename OutputStream,
+		         typename... Args,
+		         std::enable_if_t<is_output_stream_v<OutputStream>,
+		                          std::nullptr_t> = nullptr>
+		constexpr OutputStream &format( OutputStream &os, Args const &... args ) {
+			return ::daw::io::format( os, impl::fixed_format<Str>{}, args... );
+		}
+#endif
+	} // namespace io
+} // namespace daw
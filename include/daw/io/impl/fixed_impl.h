@@ -0,0 +1,242 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2019 Darrell Wright
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files( the "Software" ), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and / or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "../ostream_converters_impl.h"
+#include "../ostream_converters_int.h"
+#include "ryu_impl.h"
+
+// Exact fixed precision output of binary floating point numbers, the same
+// digits as printf's %.Nf, using only integer arithmetic
+namespace ostream_converters {
+	namespace impl {
+		// value = mantissa * 2^exponent
+		struct binary_fp {
+			uint64_t mantissa;
+			int32_t exponent;
+		};
+
+		template<typename Float>
+		constexpr binary_fp to_binary_fp( float_parts parts ) noexcept {
+			using info = float_info<Float>;
+			constexpr auto const mantissa_bits =
+			  static_cast<int32_t>( info::mantissa_bits );
+			if( parts.exponent == 0 ) {
+				return {parts.mantissa, 1 - info::bias - mantissa_bits};
+			}
+			return {parts.mantissa | ( 1ULL << info::mantissa_bits ),
+			        static_cast<int32_t>( parts.exponent ) - info::bias -
+			          mantissa_bits};
+		}
+
+		// Write exactly width digits of value, zero padded on the left
+		template<typename CharT>
+		constexpr void format_unsigned_padded( CharT *first, uint64_t value,
+		                                       uint32_t width ) noexcept {
+			CharT *ptr = first + width;
+			for( ; width >= 2U; width -= 2U ) {
+				auto const idx = static_cast<size_t>( value % 100U ) * 2U;
+				value /= 100U;
+				*--ptr = static_cast<CharT>( digit_pairs[idx + 1] );
+				*--ptr = static_cast<CharT>( digit_pairs[idx] );
+			}
+			if( width == 1U ) {
+				*--ptr = static_cast<CharT>( '0' + static_cast<char>( value % 10U ) );
+			}
+		}
+
+		// Add one to the last digit of [first, last), carrying over the decimal
+		// point.  When every digit is a 9 a leading 1 is added and the new end
+		// returned
+		template<typename CharT, typename Traits>
+		constexpr CharT *round_up_digits( CharT *first, CharT *last ) noexcept {
+			CharT *pos = last;
+			while( pos != first ) {
+				--pos;
+				if( *pos == Traits::decimal_point ) {
+					continue;
+				}
+				if( *pos != Traits::get_char_digit( 9 ) ) {
+					++*pos;
+					return last;
+				}
+				*pos = Traits::get_char_digit( 0 );
+			}
+			for( pos = last; pos != first; --pos ) {
+				*pos = *( pos - 1 );
+			}
+			*first = Traits::get_char_digit( 1 );
+			return last + 1;
+		}
+
+		// mantissa * 2^exponent can be up to 309 digits long.  Double it up in
+		// base 10^9 limbs and write them out
+		template<typename CharT>
+		constexpr CharT *format_big_whole( CharT *first, uint64_t mantissa,
+		                                   int32_t exponent ) noexcept {
+			constexpr uint32_t const limb_base = 1'000'000'000U;
+			uint32_t limbs[36]{};
+			size_t count = 0;
+			while( mantissa > 0 ) {
+				limbs[count++] = static_cast<uint32_t>( mantissa % limb_base );
+				mantissa /= limb_base;
+			}
+			while( exponent > 0 ) {
+				// limb << bits + carry must stay below 2^64
+				auto const bits = static_cast<uint32_t>( exponent < 29 ? exponent : 29 );
+				uint64_t carry = 0;
+				for( size_t n = 0; n < count; ++n ) {
+					auto const tmp = ( static_cast<uint64_t>( limbs[n] ) << bits ) + carry;
+					limbs[n] = static_cast<uint32_t>( tmp % limb_base );
+					carry = tmp / limb_base;
+				}
+				while( carry > 0 ) {
+					limbs[count++] = static_cast<uint32_t>( carry % limb_base );
+					carry /= limb_base;
+				}
+				exponent -= static_cast<int32_t>( bits );
+			}
+			first = format_unsigned( first, limbs[count - 1] );
+			for( size_t n = count - 1; n > 0; --n ) {
+				format_unsigned_padded( first, limbs[n - 1], 9U );
+				first += 9;
+			}
+			return first;
+		}
+
+		// Fractional digits of numbers with more than 64 fractional bits or more
+		// than 19 digits requested.  The fraction is held as a binary number with
+		// the binary point above the top limb, each multiply by 10 moves the next
+		// decimal digit out of the top
+		template<typename CharT, typename Traits>
+		constexpr CharT *format_fixed_slow( CharT *const first, binary_fp v,
+		                                    uint32_t precision ) noexcept {
+			auto const shift = static_cast<uint32_t>( -v.exponent );
+			CharT *last = format_unsigned(
+			  first, shift < 64U ? v.mantissa >> shift : uint64_t{0} );
+
+			uint32_t limbs[36]{};
+			uint32_t const limb_count = ( shift + 31U ) / 32U;
+			uint32_t const pad = limb_count * 32U - shift;
+			uint64_t const frac =
+			  shift < 64U ? v.mantissa & ( ( 1ULL << shift ) - 1ULL ) : v.mantissa;
+			uint64_t const frac_low = frac << pad;
+			uint64_t const frac_high = pad == 0U ? 0U : frac >> ( 64U - pad );
+			limbs[0] = static_cast<uint32_t>( frac_low );
+			if( limb_count > 1U ) {
+				limbs[1] = static_cast<uint32_t>( frac_low >> 32U );
+			}
+			if( limb_count > 2U ) {
+				limbs[2] = static_cast<uint32_t>( frac_high );
+			}
+
+			if( precision > 0U ) {
+				*last++ = Traits::decimal_point;
+			}
+			uint32_t low = 0;
+			for( uint32_t n = 0; n < precision; ++n ) {
+				while( low < limb_count && limbs[low] == 0U ) {
+					++low;
+				}
+				if( low == limb_count ) {
+					for( ; n < precision; ++n ) {
+						*last++ = Traits::get_char_digit( 0 );
+					}
+					return last;
+				}
+				uint64_t carry = 0;
+				for( uint32_t i = low; i < limb_count; ++i ) {
+					auto const tmp = static_cast<uint64_t>( limbs[i] ) * 10U + carry;
+					limbs[i] = static_cast<uint32_t>( tmp );
+					carry = tmp >> 32U;
+				}
+				*last++ = Traits::get_char_digit( carry );
+			}
+			// What is left is the remainder as a fraction of the last digit
+			auto const top = limbs[limb_count - 1U];
+			if( ( top & 0x8000'0000U ) == 0U ) {
+				return last;
+			}
+			bool is_half = top == 0x8000'0000U;
+			for( uint32_t i = low; is_half && i + 1U < limb_count; ++i ) {
+				is_half = limbs[i] == 0U;
+			}
+			auto const last_digit = last[-1] - Traits::get_char_digit( 0 );
+			if( is_half && ( last_digit & 1 ) == 0 ) {
+				return last;
+			}
+			return round_up_digits<CharT, Traits>( first, last );
+		}
+
+		// Write v with precision digits after the decimal point, rounding half to
+		// even
+		template<typename CharT, typename Traits>
+		constexpr CharT *format_fixed_digits( CharT *first, binary_fp v,
+		                                      uint32_t precision ) noexcept {
+			if( v.exponent >= 0 ) {
+				if( v.exponent <= 10 ) {
+					first = format_unsigned( first, v.mantissa << v.exponent );
+				} else {
+					first = format_big_whole( first, v.mantissa, v.exponent );
+				}
+				if( precision > 0U ) {
+					*first++ = Traits::decimal_point;
+					for( uint32_t n = 0; n < precision; ++n ) {
+						*first++ = Traits::get_char_digit( 0 );
+					}
+				}
+				return first;
+			}
+			auto const shift = static_cast<uint32_t>( -v.exponent );
+			if( shift >= 64U || precision > 19U ) {
+				return format_fixed_slow<CharT, Traits>( first, v, precision );
+			}
+			// fraction * 10^precision fits in 128 bits and the quotient by 2^shift
+			// in 64
+			auto whole = v.mantissa >> shift;
+			auto const mask = ( 1ULL << shift ) - 1ULL;
+			auto const product =
+			  ryu::umul128( v.mantissa & mask, powers_of_ten[precision] );
+			auto digits = ryu::shift_right( product, shift );
+			auto const remainder = product.low & mask;
+			auto const half = 1ULL << ( shift - 1U );
+			auto const last_digit = precision == 0U ? whole : digits;
+			if( remainder > half || ( remainder == half && ( last_digit & 1U ) ) ) {
+				if( ++digits == powers_of_ten[precision] ) {
+					digits = 0;
+					++whole;
+				}
+			}
+			first = format_unsigned( first, whole );
+			if( precision > 0U ) {
+				*first++ = Traits::decimal_point;
+				format_unsigned_padded( first, digits, precision );
+				first += precision;
+			}
+			return first;
+		}
+	} // namespace impl
+} // namespace ostream_converters
@@ -0,0 +1,610 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2019 Darrell Wright
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files( the "Software" ), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and / or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+#include "ryu_tables.h"
+
+#if defined( __has_builtin )
+#if __has_builtin( __builtin_bit_cast )
+#define DAW_IO_HAS_BUILTIN_BIT_CAST
+#endif
+#endif
+
+// Shortest round trip decimal conversion of IEEE754 floating point numbers.
+// This follows Ryu by Ulf Adams, https://github.com/ulfjack/ryu
+namespace ostream_converters {
+	namespace impl {
+		template<typename Float>
+		struct float_info;
+
+		template<>
+		struct float_info<double> {
+			using bits_t = uint64_t;
+			static constexpr uint32_t const mantissa_bits = 52;
+			static constexpr uint32_t const exponent_bits = 11;
+			static constexpr int32_t const bias = 1023;
+		};
+
+		template<>
+		struct float_info<float> {
+			using bits_t = uint32_t;
+			static constexpr uint32_t const mantissa_bits = 23;
+			static constexpr uint32_t const exponent_bits = 8;
+			static constexpr int32_t const bias = 127;
+		};
+
+		// The fields of an IEEE754 number, mantissa without the implicit bit and
+		// the biased exponent
+		struct float_parts {
+			uint64_t mantissa;
+			uint32_t exponent;
+			bool negative;
+		};
+
+		// value must be finite and not zero
+		template<typename Float>
+		constexpr float_parts decompose( Float value ) noexcept {
+			using info = float_info<Float>;
+#ifdef DAW_IO_HAS_BUILTIN_BIT_CAST
+			auto const bits =
+			  __builtin_bit_cast( typename info::bits_t, value );
+			return {
+			  static_cast<uint64_t>( bits ) &
+			    ( ( 1ULL << info::mantissa_bits ) - 1ULL ),
+			  static_cast<uint32_t>( bits >> info::mantissa_bits ) &
+			    ( ( 1U << info::exponent_bits ) - 1U ),
+			  ( bits >> ( info::mantissa_bits + info::exponent_bits ) ) != 0};
+#else
+			// No way to look at the bits in a constant expression.  Scale the value
+			// into [1, 2) by powers of two, as that is exact, and count the shifts
+			float_parts result{0, 0, value < static_cast<Float>( 0 )};
+			if( result.negative ) {
+				value = -value;
+			}
+			constexpr int32_t const steps =
+			  info::exponent_bits == 11 ? 10 : info::exponent_bits - 1;
+			Float p2[steps]{};
+			p2[0] = static_cast<Float>( 2 );
+			for( int32_t n = 1; n < steps; ++n ) {
+				p2[n] = p2[n - 1] * p2[n - 1];
+			}
+			auto const mantissa_scale =
+			  static_cast<Float>( 1ULL << info::mantissa_bits );
+			int32_t e2 = 0;
+			if( value < std::numeric_limits<Float>::min( ) ) {
+				value *= mantissa_scale;
+				e2 -= static_cast<int32_t>( info::mantissa_bits );
+			}
+			for( int32_t n = steps - 1; n >= 0; --n ) {
+				if( value >= p2[n] ) {
+					value /= p2[n];
+					e2 += 1 << n;
+				}
+			}
+			for( int32_t n = steps - 1; n >= 0; --n ) {
+				if( value * p2[n] < p2[0] ) {
+					value *= p2[n];
+					e2 -= 1 << n;
+				}
+			}
+			auto const m = static_cast<uint64_t>( value * mantissa_scale );
+			auto const biased = e2 + info::bias;
+			if( biased >= 1 ) {
+				result.mantissa = m - ( 1ULL << info::mantissa_bits );
+				result.exponent = static_cast<uint32_t>( biased );
+			} else {
+				result.mantissa = m >> static_cast<uint32_t>( 1 - biased );
+			}
+			return result;
+#endif
+		}
+
+		// A decimal floating point number, value = mantissa * 10^exponent
+		struct decimal_fp {
+			uint64_t mantissa;
+			int32_t exponent;
+		};
+
+		namespace ryu {
+			struct uint128_t {
+				uint64_t low;
+				uint64_t high;
+			};
+
+			constexpr uint128_t umul128( uint64_t a, uint64_t b ) noexcept {
+#if defined( __SIZEOF_INT128__ )
+				__extension__ using native_t = unsigned __int128;
+				auto const r = static_cast<native_t>( a ) * static_cast<native_t>( b );
+				return {static_cast<uint64_t>( r ), static_cast<uint64_t>( r >> 64U )};
+#else
+				auto const a_lo = a & 0xFFFF'FFFFULL;
+				auto const a_hi = a >> 32U;
+				auto const b_lo = b & 0xFFFF'FFFFULL;
+				auto const b_hi = b >> 32U;
+
+				auto const lo_lo = a_lo * b_lo;
+				auto const hi_lo = a_hi * b_lo;
+				auto const lo_hi = a_lo * b_hi;
+				auto const hi_hi = a_hi * b_hi;
+
+				auto const cross =
+				  ( lo_lo >> 32U ) + ( hi_lo & 0xFFFF'FFFFULL ) + lo_hi;
+				return {( cross << 32U ) | ( lo_lo & 0xFFFF'FFFFULL ),
+				        ( hi_lo >> 32U ) + ( cross >> 32U ) + hi_hi};
+#endif
+			}
+
+			constexpr uint128_t add( uint128_t lhs, uint128_t rhs ) noexcept {
+				auto const low = lhs.low + rhs.low;
+				return {low, lhs.high + rhs.high + ( low < lhs.low ? 1U : 0U )};
+			}
+
+			// 0 < dist < 64
+			constexpr uint64_t shift_right( uint128_t v, uint32_t dist ) noexcept {
+				return ( v.high << ( 64U - dist ) ) | ( v.low >> dist );
+			}
+
+			// ceil( log2( 5^e ) ), or 1 when e is 0.  Valid for 0 <= e <= 3528
+			constexpr int32_t pow5bits( int32_t e ) noexcept {
+				return static_cast<int32_t>(
+				  ( ( static_cast<uint32_t>( e ) * 1217359U ) >> 19U ) + 1U );
+			}
+
+			// floor( log10( 2^e ) ).  Valid for 0 <= e <= 1650
+			constexpr uint32_t log10_pow2( int32_t e ) noexcept {
+				return ( static_cast<uint32_t>( e ) * 78913U ) >> 18U;
+			}
+
+			// floor( log10( 5^e ) ).  Valid for 0 <= e <= 2620
+			constexpr uint32_t log10_pow5( int32_t e ) noexcept {
+				return ( static_cast<uint32_t>( e ) * 732923U ) >> 20U;
+			}
+
+			constexpr bool multiple_of_power_of_5( uint64_t value,
+			                                       uint32_t p ) noexcept {
+				uint32_t count = 0;
+				while( value % 5U == 0 ) {
+					value /= 5U;
+					++count;
+				}
+				return count >= p;
+			}
+
+			constexpr bool multiple_of_power_of_2( uint64_t value,
+			                                       uint32_t p ) noexcept {
+				return ( value & ( ( 1ULL << p ) - 1ULL ) ) == 0;
+			}
+
+			inline constexpr int32_t const pow5_inv_bitcount = 125;
+			inline constexpr int32_t const pow5_bitcount = 125;
+
+#ifndef SMALL_MEMORY
+			constexpr uint128_t pow5( uint32_t i ) noexcept {
+				return {double_pow5_split[i][0], double_pow5_split[i][1]};
+			}
+
+			constexpr uint128_t inv_pow5( uint32_t i ) noexcept {
+				return {double_pow5_inv_split[i][0], double_pow5_inv_split[i][1]};
+			}
+#else
+			constexpr uint32_t table_offset( uint32_t const *offsets,
+			                                 uint32_t i ) noexcept {
+				return ( offsets[i / 16U] >> ( ( i % 16U ) * 2U ) ) & 3U;
+			}
+
+			// The low 128 bits of the 192 bit ( m * mul ) >> dist, 0 < dist < 64
+			constexpr uint128_t mul_shift128( uint64_t m, uint128_t mul,
+			                                  uint32_t dist ) noexcept {
+				auto const b0 = umul128( m, mul.low );
+				auto const b2 = umul128( m, mul.high );
+				auto const sum = add( b2, uint128_t{b0.high, 0} );
+				return {shift_right( uint128_t{b0.low, sum.low}, dist ),
+				        shift_right( sum, dist )};
+			}
+
+			constexpr uint128_t pow5( uint32_t i ) noexcept {
+				auto const base = i / pow5_table_size;
+				auto const base2 = base * pow5_table_size;
+				auto const offset = i - base2;
+				uint128_t const mul{double_pow5_split2[base][0],
+				                    double_pow5_split2[base][1]};
+				if( offset == 0 ) {
+					return mul;
+				}
+				auto const delta = static_cast<uint32_t>(
+				  pow5bits( static_cast<int32_t>( i ) ) -
+				  pow5bits( static_cast<int32_t>( base2 ) ) );
+				auto result = mul_shift128( double_pow5_table[offset], mul, delta );
+				result.low += table_offset( pow5_offsets, i );
+				return result;
+			}
+
+			constexpr uint128_t inv_pow5( uint32_t i ) noexcept {
+				auto const base = ( i + pow5_table_size - 1U ) / pow5_table_size;
+				auto const base2 = base * pow5_table_size;
+				auto const offset = base2 - i;
+				uint128_t const mul{double_pow5_inv_split2[base][0],
+				                    double_pow5_inv_split2[base][1]};
+				if( offset == 0 ) {
+					return mul;
+				}
+				auto const delta = static_cast<uint32_t>(
+				  pow5bits( static_cast<int32_t>( base2 ) ) -
+				  pow5bits( static_cast<int32_t>( i ) ) );
+				auto result = mul_shift128( double_pow5_table[offset],
+				                            uint128_t{mul.low - 1U, mul.high}, delta );
+				result.low += 1U + table_offset( pow5_inv_offsets, i );
+				return result;
+			}
+#endif
+
+			// ( m * mul ) >> j where j >= 64
+			constexpr uint64_t mul_shift64( uint64_t m, uint128_t mul,
+			                                int32_t j ) noexcept {
+				auto const b0 = umul128( m, mul.low );
+				auto const b2 = umul128( m, mul.high );
+				return shift_right( add( b2, uint128_t{b0.high, 0} ),
+				                    static_cast<uint32_t>( j - 64 ) );
+			}
+
+			// Whole numbers below 2^( mantissa_bits + 1 ) are exact and do not
+			// need the full algorithm
+			template<typename Float>
+			constexpr bool small_int( uint64_t m2, int32_t e2,
+			                          decimal_fp &result ) noexcept {
+				using info = float_info<Float>;
+				if( e2 > 0 || e2 < -static_cast<int32_t>( info::mantissa_bits ) ) {
+					return false;
+				}
+				auto const shift = static_cast<uint32_t>( -e2 );
+				if( ( m2 & ( ( 1ULL << shift ) - 1ULL ) ) != 0 ) {
+					return false;
+				}
+				result.mantissa = m2 >> shift;
+				result.exponent = 0;
+				while( true ) {
+					auto const q = result.mantissa / 10U;
+					if( result.mantissa - 10U * q != 0 ) {
+						break;
+					}
+					result.mantissa = q;
+					++result.exponent;
+				}
+				return true;
+			}
+		} // namespace ryu
+
+		constexpr decimal_fp to_shortest_decimal64( float_parts parts ) noexcept {
+			using info = float_info<double>;
+			using namespace ryu;
+
+			int32_t e2 = 0;
+			uint64_t m2 = 0;
+			if( parts.exponent == 0 ) {
+				e2 = 1 - info::bias - static_cast<int32_t>( info::mantissa_bits ) - 2;
+				m2 = parts.mantissa;
+			} else {
+				e2 = static_cast<int32_t>( parts.exponent ) - info::bias -
+				     static_cast<int32_t>( info::mantissa_bits ) - 2;
+				m2 = ( 1ULL << info::mantissa_bits ) | parts.mantissa;
+
+				decimal_fp result{0, 0};
+				if( small_int<double>( m2, e2 + 2, result ) ) {
+					return result;
+				}
+			}
+			bool const accept_bounds = ( m2 & 1U ) == 0;
+
+			// Step 2: Determine the interval of valid decimal representations
+			uint64_t const mv = 4U * m2;
+			uint64_t const mm_shift =
+			  ( parts.mantissa != 0 || parts.exponent <= 1 ) ? 1U : 0U;
+
+			// Step 3: Convert to a decimal power base using 128 bit arithmetic
+			uint64_t vr = 0;
+			uint64_t vp = 0;
+			uint64_t vm = 0;
+			int32_t e10 = 0;
+			bool vm_is_trailing_zeros = false;
+			bool vr_is_trailing_zeros = false;
+			if( e2 >= 0 ) {
+				auto const q = log10_pow2( e2 ) - ( e2 > 3 ? 1U : 0U );
+				e10 = static_cast<int32_t>( q );
+				auto const k =
+				  pow5_inv_bitcount + pow5bits( static_cast<int32_t>( q ) ) - 1;
+				auto const i = -e2 + static_cast<int32_t>( q ) + k;
+				auto const mul = inv_pow5( q );
+				vr = mul_shift64( 4U * m2, mul, i );
+				vp = mul_shift64( 4U * m2 + 2U, mul, i );
+				vm = mul_shift64( 4U * m2 - 1U - mm_shift, mul, i );
+				if( q <= 21 ) {
+					// Only one of mp, mv, and mm can be a multiple of 5, if any
+					if( mv % 5U == 0 ) {
+						vr_is_trailing_zeros = multiple_of_power_of_5( mv, q );
+					} else if( accept_bounds ) {
+						vm_is_trailing_zeros =
+						  multiple_of_power_of_5( mv - 1U - mm_shift, q );
+					} else {
+						vp -= multiple_of_power_of_5( mv + 2U, q ) ? 1U : 0U;
+					}
+				}
+			} else {
+				auto const q = log10_pow5( -e2 ) - ( -e2 > 1 ? 1U : 0U );
+				e10 = static_cast<int32_t>( q ) + e2;
+				auto const i = -e2 - static_cast<int32_t>( q );
+				auto const k = pow5bits( i ) - pow5_bitcount;
+				auto const j = static_cast<int32_t>( q ) - k;
+				auto const mul = pow5( static_cast<uint32_t>( i ) );
+				vr = mul_shift64( 4U * m2, mul, j );
+				vp = mul_shift64( 4U * m2 + 2U, mul, j );
+				vm = mul_shift64( 4U * m2 - 1U - mm_shift, mul, j );
+				if( q <= 1 ) {
+					// mv = 4 * m2 always has at least two trailing 0 bits
+					vr_is_trailing_zeros = true;
+					if( accept_bounds ) {
+						// mm = mv - 1 - mm_shift has a trailing 0 bit iff mm_shift is 1
+						vm_is_trailing_zeros = mm_shift == 1;
+					} else {
+						// mp = mv + 2 always has at least one trailing 0 bit
+						--vp;
+					}
+				} else if( q < 63 ) {
+					vr_is_trailing_zeros = multiple_of_power_of_2( mv, q );
+				}
+			}
+
+			// Step 4: Find the shortest decimal representation in the interval
+			int32_t removed = 0;
+			uint64_t output = 0;
+			if( vm_is_trailing_zeros || vr_is_trailing_zeros ) {
+				// The rare general case
+				uint32_t last_removed_digit = 0;
+				while( vp / 10U > vm / 10U ) {
+					vm_is_trailing_zeros &= vm % 10U == 0;
+					vr_is_trailing_zeros &= last_removed_digit == 0;
+					last_removed_digit = static_cast<uint32_t>( vr % 10U );
+					vr /= 10U;
+					vp /= 10U;
+					vm /= 10U;
+					++removed;
+				}
+				if( vm_is_trailing_zeros ) {
+					while( vm % 10U == 0 ) {
+						vr_is_trailing_zeros &= last_removed_digit == 0;
+						last_removed_digit = static_cast<uint32_t>( vr % 10U );
+						vr /= 10U;
+						vp /= 10U;
+						vm /= 10U;
+						++removed;
+					}
+				}
+				if( vr_is_trailing_zeros && last_removed_digit == 5 && vr % 2U == 0 ) {
+					// Round even if the exact number is .....50..0
+					last_removed_digit = 4;
+				}
+				output =
+				  vr + ( ( vr == vm && ( !accept_bounds || !vm_is_trailing_zeros ) ) ||
+				             last_removed_digit >= 5
+				           ? 1U
+				           : 0U );
+			} else {
+				// The common case, remove two digits at a time while possible
+				bool round_up = false;
+				if( vp / 100U > vm / 100U ) {
+					round_up = vr % 100U >= 50U;
+					vr /= 100U;
+					vp /= 100U;
+					vm /= 100U;
+					removed += 2;
+				}
+				while( vp / 10U > vm / 10U ) {
+					round_up = vr % 10U >= 5U;
+					vr /= 10U;
+					vp /= 10U;
+					vm /= 10U;
+					++removed;
+				}
+				output = vr + ( vr == vm || round_up ? 1U : 0U );
+			}
+			return {output, e10 + removed};
+		}
+
+		namespace ryu {
+			// The float kernel uses the upper 64 bits of the double tables
+			inline constexpr int32_t const float_pow5_inv_bitcount =
+			  pow5_inv_bitcount - 64;
+			inline constexpr int32_t const float_pow5_bitcount = pow5_bitcount - 64;
+
+			// ( m * factor ) >> shift where shift > 32
+			constexpr uint32_t mul_shift32( uint32_t m, uint64_t factor,
+			                                int32_t shift ) noexcept {
+				auto const bits0 =
+				  static_cast<uint64_t>( m ) * static_cast<uint32_t>( factor );
+				auto const bits1 =
+				  static_cast<uint64_t>( m ) * static_cast<uint32_t>( factor >> 32U );
+				auto const sum = ( bits0 >> 32U ) + bits1;
+				return static_cast<uint32_t>( sum >>
+				                              static_cast<uint32_t>( shift - 32 ) );
+			}
+
+			constexpr uint32_t mul_pow5_inv_div_pow2( uint32_t m, uint32_t q,
+			                                          int32_t j ) noexcept {
+				return mul_shift32( m, inv_pow5( q ).high + 1U, j );
+			}
+
+			constexpr uint32_t mul_pow5_div_pow2( uint32_t m, uint32_t i,
+			                                      int32_t j ) noexcept {
+				return mul_shift32( m, pow5( i ).high, j );
+			}
+		} // namespace ryu
+
+		// Single precision needs no more than 32 bit digits and 64 bit products
+		constexpr decimal_fp to_shortest_decimal32( float_parts parts ) noexcept {
+			using info = float_info<float>;
+			using namespace ryu;
+
+			int32_t e2 = 0;
+			uint32_t m2 = 0;
+			if( parts.exponent == 0 ) {
+				e2 = 1 - info::bias - static_cast<int32_t>( info::mantissa_bits ) - 2;
+				m2 = static_cast<uint32_t>( parts.mantissa );
+			} else {
+				e2 = static_cast<int32_t>( parts.exponent ) - info::bias -
+				     static_cast<int32_t>( info::mantissa_bits ) - 2;
+				m2 = ( 1U << info::mantissa_bits ) |
+				     static_cast<uint32_t>( parts.mantissa );
+			}
+			bool const accept_bounds = ( m2 & 1U ) == 0;
+
+			uint32_t const mv = 4U * m2;
+			uint32_t const mp = 4U * m2 + 2U;
+			uint32_t const mm_shift =
+			  ( parts.mantissa != 0 || parts.exponent <= 1 ) ? 1U : 0U;
+			uint32_t const mm = 4U * m2 - 1U - mm_shift;
+
+			uint32_t vr = 0;
+			uint32_t vp = 0;
+			uint32_t vm = 0;
+			int32_t e10 = 0;
+			bool vm_is_trailing_zeros = false;
+			bool vr_is_trailing_zeros = false;
+			uint32_t last_removed_digit = 0;
+			if( e2 >= 0 ) {
+				auto const q = log10_pow2( e2 );
+				e10 = static_cast<int32_t>( q );
+				auto const k =
+				  float_pow5_inv_bitcount + pow5bits( static_cast<int32_t>( q ) ) - 1;
+				auto const i = -e2 + static_cast<int32_t>( q ) + k;
+				vr = mul_pow5_inv_div_pow2( mv, q, i );
+				vp = mul_pow5_inv_div_pow2( mp, q, i );
+				vm = mul_pow5_inv_div_pow2( mm, q, i );
+				if( q != 0 && ( vp - 1U ) / 10U <= vm / 10U ) {
+					// One removed digit is needed even when the loop below will not
+					// run.  Using q - 1 above would need 33 bits
+					auto const l = float_pow5_inv_bitcount +
+					               pow5bits( static_cast<int32_t>( q - 1U ) ) - 1;
+					last_removed_digit =
+					  mul_pow5_inv_div_pow2( mv, q - 1U,
+					                         -e2 + static_cast<int32_t>( q ) - 1 + l ) %
+					  10U;
+				}
+				if( q <= 9 ) {
+					// Only one of mp, mv, and mm can be a multiple of 5, if any
+					if( mv % 5U == 0 ) {
+						vr_is_trailing_zeros = multiple_of_power_of_5( mv, q );
+					} else if( accept_bounds ) {
+						vm_is_trailing_zeros = multiple_of_power_of_5( mm, q );
+					} else {
+						vp -= multiple_of_power_of_5( mp, q ) ? 1U : 0U;
+					}
+				}
+			} else {
+				auto const q = log10_pow5( -e2 );
+				e10 = static_cast<int32_t>( q ) + e2;
+				auto const i = -e2 - static_cast<int32_t>( q );
+				auto const k = pow5bits( i ) - float_pow5_bitcount;
+				auto j = static_cast<int32_t>( q ) - k;
+				vr = mul_pow5_div_pow2( mv, static_cast<uint32_t>( i ), j );
+				vp = mul_pow5_div_pow2( mp, static_cast<uint32_t>( i ), j );
+				vm = mul_pow5_div_pow2( mm, static_cast<uint32_t>( i ), j );
+				if( q != 0 && ( vp - 1U ) / 10U <= vm / 10U ) {
+					j = static_cast<int32_t>( q ) - 1 -
+					    ( pow5bits( i + 1 ) - float_pow5_bitcount );
+					last_removed_digit =
+					  mul_pow5_div_pow2( mv, static_cast<uint32_t>( i + 1 ), j ) % 10U;
+				}
+				if( q <= 1 ) {
+					// mv = 4 * m2 always has at least two trailing 0 bits
+					vr_is_trailing_zeros = true;
+					if( accept_bounds ) {
+						// mm = mv - 1 - mm_shift has a trailing 0 bit iff mm_shift is 1
+						vm_is_trailing_zeros = mm_shift == 1;
+					} else {
+						// mp = mv + 2 always has at least one trailing 0 bit
+						--vp;
+					}
+				} else if( q < 31 ) {
+					vr_is_trailing_zeros = multiple_of_power_of_2( mv, q - 1U );
+				}
+			}
+
+			int32_t removed = 0;
+			uint32_t output = 0;
+			if( vm_is_trailing_zeros || vr_is_trailing_zeros ) {
+				while( vp / 10U > vm / 10U ) {
+					vm_is_trailing_zeros &= vm % 10U == 0;
+					vr_is_trailing_zeros &= last_removed_digit == 0;
+					last_removed_digit = vr % 10U;
+					vr /= 10U;
+					vp /= 10U;
+					vm /= 10U;
+					++removed;
+				}
+				if( vm_is_trailing_zeros ) {
+					while( vm % 10U == 0 ) {
+						vr_is_trailing_zeros &= last_removed_digit == 0;
+						last_removed_digit = vr % 10U;
+						vr /= 10U;
+						vp /= 10U;
+						vm /= 10U;
+						++removed;
+					}
+				}
+				if( vr_is_trailing_zeros && last_removed_digit == 5 && vr % 2U == 0 ) {
+					// Round even if the exact number is .....50..0
+					last_removed_digit = 4;
+				}
+				output =
+				  vr + ( ( vr == vm && ( !accept_bounds || !vm_is_trailing_zeros ) ) ||
+				             last_removed_digit >= 5
+				           ? 1U
+				           : 0U );
+			} else {
+				while( vp / 10U > vm / 10U ) {
+					last_removed_digit = vr % 10U;
+					vr /= 10U;
+					vp /= 10U;
+					vm /= 10U;
+					++removed;
+				}
+				output = vr + ( vr == vm || last_removed_digit >= 5 ? 1U : 0U );
+			}
+			return {output, e10 + removed};
+		}
+
+		// The shortest decimal that rounds to the same floating point value,
+		// choosing the closest to the exact value when there is more than one
+		template<typename Float>
+		constexpr decimal_fp to_shortest_decimal( float_parts parts ) noexcept {
+			if constexpr( std::is_same_v<Float, float> ) {
+				return to_shortest_decimal32( parts );
+			} else {
+				return to_shortest_decimal64( parts );
+			}
+		}
+	} // namespace impl
+} // namespace ostream_converters
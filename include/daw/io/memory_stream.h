@@ -27,20 +27,48 @@
 #include <string>
 #endif
 
+#include <cstdlib>
+
 #include <daw/daw_traits.h>
 
 #include "ostreams.h"
 
 namespace daw {
 	namespace io {
-		template<typename CharT = char>
+		// What a memory_stream does when a write does not fit.  throw_exception
+		// throws buffer_full_exception, truncate writes what fits and counts the
+		// rest in dropped( ) and abort calls std::abort
+		enum class overflow_policy { throw_exception, truncate, abort };
+
+		template<typename CharT = char,
+		         overflow_policy Policy = overflow_policy::throw_exception>
 		class memory_stream {
 			static_assert( !::std::is_const_v<CharT>,
 			               "Cannot write to a const buffer" );
 			size_t m_capacity = 0;
 			size_t m_position = 0;
+			size_t m_dropped = 0;
 			CharT *m_first = nullptr;
 
+			static constexpr bool const is_noexcept =
+			  Policy != overflow_policy::throw_exception;
+
+			// The part of a count character write that can go ahead
+			constexpr size_t fit( size_t count ) noexcept( is_noexcept ) {
+				auto const room = capacity( ) - size( );
+				if( count <= room ) {
+					return count;
+				}
+				if constexpr( Policy == overflow_policy::throw_exception ) {
+					::daw::exception::precondition_check<buffer_full_exception>(
+					  false );
+				} else if constexpr( Policy == overflow_policy::abort ) {
+					std::abort( );
+				}
+				m_dropped += count - room;
+				return room;
+			}
+
 		public:
 			// OutputStream Interface
 			using character_t = CharT;
@@ -70,6 +98,15 @@ namespace daw {
 				return size( ) == capacity( );
 			}
 
+			// Characters that did not fit with overflow_policy::truncate
+			constexpr size_t dropped( ) const noexcept {
+				return m_dropped;
+			}
+
+			constexpr bool truncated( ) const noexcept {
+				return m_dropped > 0;
+			}
+
 		private:
 			constexpr void append( CharT c ) noexcept {
 				m_first[m_position++] = c;
@@ -77,10 +114,20 @@ namespace daw {
 
 		public:
 			// OutputStream Interface
-			constexpr void operator( )( CharT c ) {
-				::daw::exception::precondition_check<buffer_full_exception>(
-				  !is_full( ) );
-				append( c );
+			constexpr void operator( )( CharT c ) noexcept( is_noexcept ) {
+				if( fit( 1 ) == 1 ) {
+					append( c );
+				}
+			}
+
+			// OutputStream Interface
+			constexpr void operator( )( ::daw::io::impl::accept_sized,
+			                            CharT const *ptr,
+			                            size_t count ) noexcept( is_noexcept ) {
+				// One check up front, then an unchecked copy
+				auto const sz = fit( count );
+				impl::copy_chars( m_first + m_position, ptr, sz );
+				m_position += sz;
 			}
 
 			// OutputStream Interface
@@ -88,24 +135,48 @@ namespace daw {
 			         std::enable_if_t<( ::daw::impl::is_string_like_v<String> &&
 			                            !::daw::traits::is_character_v<String>),
 			                          std::nullptr_t> = nullptr>
-			constexpr void operator( )( String &&str ) {
+			constexpr void operator( )( String &&str ) noexcept( is_noexcept ) {
 				static_assert(
 				  std::is_same_v<remove_cvref_t<CharT>,
 				                 remove_cvref_t<decltype( *str.data( ) )>>,
 				  "String's data( ) character type must match that of output stream" );
 
-				::daw::exception::precondition_check<buffer_full_exception>(
-				  str.size( ) <= capacity( ) - size( ) );
+				operator( )( ::daw::io::impl::accept_sized{}, str.data( ),
+				             static_cast<size_t>( str.size( ) ) );
+			}
 
-				auto ptr = str.data( );
-				auto const sz = str.size( );
-				for( size_t n = 0; n < sz; ++n ) {
-					append( *ptr++ );
+			// Direct formatting, nullptr when fewer than n characters are left
+			constexpr CharT *prepare( size_t n ) noexcept {
+				if( n > capacity( ) - size( ) ) {
+					return nullptr;
 				}
+				return m_first + m_position;
+			}
+
+			constexpr void commit( size_t n ) noexcept {
+				m_position += n;
 			}
 
 			constexpr void reset( ) noexcept {
 				m_position = 0;
+				m_dropped = 0;
+			}
+
+			// A position to rewind to, with the count of dropped characters
+			struct mark_t {
+				size_t position;
+				size_t dropped;
+			};
+
+			constexpr mark_t mark( ) const noexcept {
+				return {m_position, m_dropped};
+			}
+
+			// Drop what was written after m, always possible
+			constexpr bool rewind( mark_t m ) noexcept {
+				m_position = m.position;
+				m_dropped = m.dropped;
+				return true;
 			}
 
 #ifndef NOSTRING
@@ -119,8 +190,8 @@ namespace daw {
 			}
 		};
 #endif
-		template<typename CharT>
-		struct supports_output_stream_interface<memory_stream<CharT>>
+		template<typename CharT, overflow_policy Policy>
+		struct supports_output_stream_interface<memory_stream<CharT, Policy>>
 		  : std::true_type {};
 
 		template<typename CharT>
@@ -128,5 +199,11 @@ namespace daw {
 		                                          size_t capacity ) noexcept {
 			return memory_stream<CharT>( buffer, capacity );
 		}
+
+		template<overflow_policy Policy, typename CharT>
+		constexpr auto make_memory_buffer_stream( CharT *buffer,
+		                                          size_t capacity ) noexcept {
+			return memory_stream<CharT, Policy>( buffer, capacity );
+		}
 	} // namespace io
 } // namespace daw
@@ -0,0 +1,315 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2019 Darrell Wright
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files( the "Software" ), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and / or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <cerrno>
+#include <cstddef>
+#include <string>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <daw/daw_exception.h>
+#include <daw/daw_string_view.h>
+#include <daw/daw_traits.h>
+
+#include "file_stream.h"
+#include "ostream_helpers.h"
+#include "ostreams.h"
+
+namespace daw {
+	namespace io {
+		namespace impl {
+			// Give the file real blocks so that running out of disk space is an
+			// error here and not a SIGBUS when the mapping is written to.  Sparse
+			// growth with ftruncate is used where that is not supported
+			inline bool extend_file( int fd, size_t old_size,
+			                         size_t new_size ) noexcept {
+#if defined( __linux__ )
+				if( ::fallocate( fd, 0, static_cast<off_t>( old_size ),
+				                 static_cast<off_t>( new_size - old_size ) ) == 0 ) {
+					return true;
+				}
+				if( errno != EOPNOTSUPP && errno != ENOSYS ) {
+					return false;
+				}
+#else
+				(void)old_size;
+#endif
+				return ::ftruncate( fd, static_cast<off_t>( new_size ) ) == 0;
+			}
+
+			inline size_t page_size( ) noexcept {
+				static size_t const result = [] {
+					auto const sz = ::sysconf( _SC_PAGESIZE );
+					return sz > 0 ? static_cast<size_t>( sz ) : size_t{4096};
+				}( );
+				return result;
+			}
+		} // namespace impl
+
+		// A POSIX file written through a shared memory mapping.  The file is grown
+		// and remapped an extent at a time and cut to the size written on close.
+		// Characters are stored as is, without the conversion a wide FILE does.
+		// Throws buffer_full_exception when the file cannot be grown
+		template<typename CharT = char>
+		class mmap_file_stream {
+			int m_fd = -1;
+			CharT *m_data = nullptr;
+			size_t m_mapped_bytes = 0;
+			size_t m_file_bytes = 0;
+			size_t m_size = 0;
+			size_t m_extent;
+
+			size_t capacity( ) const noexcept {
+				return m_mapped_bytes / sizeof( CharT );
+			}
+
+			// Nothing is mapped after an append until the first write
+			size_t room( ) const noexcept {
+				return capacity( ) > m_size ? capacity( ) - m_size : 0U;
+			}
+
+			void unmap( ) noexcept {
+				if( m_data != nullptr ) {
+					::munmap( static_cast<void *>( m_data ), m_mapped_bytes );
+					m_data = nullptr;
+					m_mapped_bytes = 0;
+				}
+			}
+
+			// Make room for at least count characters in total
+			bool grow_to( size_t count ) noexcept {
+				if( m_fd < 0 ) {
+					return false;
+				}
+				auto new_bytes = count * sizeof( CharT );
+				if( new_bytes < m_file_bytes + m_extent ) {
+					new_bytes = m_file_bytes + m_extent;
+				}
+				new_bytes = ( ( new_bytes + m_extent - 1U ) / m_extent ) * m_extent;
+				if( !impl::extend_file( m_fd, m_file_bytes, new_bytes ) ) {
+					return false;
+				}
+				m_file_bytes = new_bytes;
+				void *ptr = MAP_FAILED;
+#if defined( __linux__ )
+				if( m_data != nullptr ) {
+					ptr = ::mremap( static_cast<void *>( m_data ), m_mapped_bytes,
+					                new_bytes, MREMAP_MAYMOVE );
+					if( ptr == MAP_FAILED ) {
+						return false;
+					}
+				}
+#endif
+				if( ptr == MAP_FAILED ) {
+					unmap( );
+					ptr = ::mmap( nullptr, new_bytes, PROT_READ | PROT_WRITE, MAP_SHARED,
+					              m_fd, 0 );
+					if( ptr == MAP_FAILED ) {
+						return false;
+					}
+				}
+				m_data = static_cast<CharT *>( ptr );
+				m_mapped_bytes = new_bytes;
+				return true;
+			}
+
+			CharT *room_for( size_t count ) {
+				if( room( ) < count ) {
+					::daw::exception::precondition_check<buffer_full_exception>(
+					  grow_to( m_size + count ) );
+				}
+				return m_data + m_size;
+			}
+
+		public:
+			// OutputStream Interface
+			using character_t = CharT;
+
+			static constexpr size_t const default_extent_size = 16U * 1024U * 1024U;
+
+			// extent_size is the number of bytes the file grows by, rounded up to
+			// whole pages
+			explicit mmap_file_stream(
+			  std::string const &file_name,
+			  file_open_flags flags = file_open_flags::Write,
+			  size_t extent_size = default_extent_size ) noexcept
+			  : m_fd( ::open( file_name.c_str( ),
+			                  O_RDWR | O_CREAT | O_CLOEXEC |
+			                    ( flags == file_open_flags::Write ? O_TRUNC : 0 ),
+			                  0666 ) )
+			  , m_extent( ( ( extent_size > 0 ? extent_size : 1U ) +
+			                impl::page_size( ) - 1U ) /
+			              impl::page_size( ) * impl::page_size( ) ) {
+
+				if( m_fd >= 0 && flags == file_open_flags::Append ) {
+					struct stat st {};
+					if( ::fstat( m_fd, &st ) != 0 ) {
+						::close( std::exchange( m_fd, -1 ) );
+						return;
+					}
+					m_file_bytes = static_cast<size_t>( st.st_size );
+					m_size = ( m_file_bytes + sizeof( CharT ) - 1U ) / sizeof( CharT );
+				}
+			}
+
+			mmap_file_stream( mmap_file_stream &&other ) noexcept
+			  : m_fd( std::exchange( other.m_fd, -1 ) )
+			  , m_data( std::exchange( other.m_data, nullptr ) )
+			  , m_mapped_bytes( std::exchange( other.m_mapped_bytes, 0 ) )
+			  , m_file_bytes( std::exchange( other.m_file_bytes, 0 ) )
+			  , m_size( std::exchange( other.m_size, 0 ) )
+			  , m_extent( other.m_extent ) {}
+
+			mmap_file_stream &operator=( mmap_file_stream &&rhs ) noexcept {
+				if( this != &rhs ) {
+					close( );
+					m_fd = std::exchange( rhs.m_fd, -1 );
+					m_data = std::exchange( rhs.m_data, nullptr );
+					m_mapped_bytes = std::exchange( rhs.m_mapped_bytes, 0 );
+					m_file_bytes = std::exchange( rhs.m_file_bytes, 0 );
+					m_size = std::exchange( rhs.m_size, 0 );
+					m_extent = rhs.m_extent;
+				}
+				return *this;
+			}
+
+			mmap_file_stream( mmap_file_stream const & ) = delete;
+			mmap_file_stream &operator=( mmap_file_stream const & ) = delete;
+
+			~mmap_file_stream( ) {
+				close( );
+			}
+
+			inline explicit operator bool( ) const noexcept {
+				return m_fd >= 0;
+			}
+
+			inline int native_handle( ) const noexcept {
+				return m_fd;
+			}
+
+			// Characters in the file, including those there before an append
+			inline size_t size( ) const noexcept {
+				return m_size;
+			}
+
+			// Grow the file up front when the final size is known
+			void reserve( size_t count ) {
+				if( count > capacity( ) ) {
+					::daw::exception::precondition_check<buffer_full_exception>(
+					  grow_to( count ) );
+				}
+			}
+
+			// OutputStream Interface
+			void operator( )( CharT c ) {
+				*room_for( 1 ) = c;
+				++m_size;
+			}
+
+			// OutputStream Interface
+			void operator( )( ::daw::io::impl::accept_sized, CharT const *ptr,
+			                  size_t count ) {
+				impl::copy_chars( room_for( count ), ptr, count );
+				m_size += count;
+			}
+
+			// OutputStream Interface
+			template<typename String,
+			         std::enable_if_t<( ::daw::impl::is_string_like_v<String> &&
+			                            !::daw::traits::is_character_v<String>),
+			                          std::nullptr_t> = nullptr>
+			void operator( )( String &&str ) {
+				static_assert(
+				  std::is_same_v<remove_cvref_t<CharT>,
+				                 remove_cvref_t<decltype( *str.data( ) )>>,
+				  "String's data( ) character type must match that of output stream" );
+
+				operator( )( ::daw::io::impl::accept_sized{}, str.data( ),
+				             static_cast<size_t>( str.size( ) ) );
+			}
+
+			// Direct formatting into the mapping, nullptr when the file cannot grow
+			CharT *prepare( size_t count ) noexcept {
+				if( room( ) < count && !grow_to( m_size + count ) ) {
+					return nullptr;
+				}
+				return m_data + m_size;
+			}
+
+			void commit( size_t count ) noexcept {
+				m_size += count;
+			}
+
+			using mark_t = size_t;
+
+			mark_t mark( ) const noexcept {
+				return m_size;
+			}
+
+			// Drop what was written after m, the file keeps its length until close.
+			// Always possible, flush( ) only writes back what is mapped
+			bool rewind( mark_t m ) noexcept {
+				m_size = m;
+				return true;
+			}
+
+			// The data is in the page cache as soon as it is written, start writing
+			// it back to the file
+			void flush( ) noexcept {
+				if( m_data != nullptr ) {
+					::msync( static_cast<void *>( m_data ), m_mapped_bytes, MS_ASYNC );
+				}
+			}
+
+			// Unmap and cut the file to the characters written
+			void close( ) noexcept {
+				unmap( );
+				if( m_fd >= 0 ) {
+					(void)::ftruncate( m_fd,
+					                   static_cast<off_t>( m_size * sizeof( CharT ) ) );
+					::close( std::exchange( m_fd, -1 ) );
+				}
+				m_file_bytes = 0;
+			}
+		};
+
+		template<typename CharT>
+		struct supports_output_stream_interface<mmap_file_stream<CharT>>
+		  : std::true_type {};
+	} // namespace io
+
+	template<typename CharT = char>
+	auto make_mmap_file_stream(
+	  std::string const &file_name,
+	  io::file_open_flags flags = io::file_open_flags::Write,
+	  size_t extent_size = io::mmap_file_stream<CharT>::default_extent_size ) noexcept {
+
+		return io::mmap_file_stream<CharT>( file_name, flags, extent_size );
+	}
+} // namespace daw
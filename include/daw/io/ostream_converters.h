@@ -112,4 +112,239 @@ namespace ostream_converters {
 	constexpr bool has_to_os_string_v =
 	  daw::is_detected_v<impl::to_os_string_detect::has_to_os_string_detect,
 	                     CharT, ::daw::remove_cvref_t<T>>;
+
+	// Formatting straight into an output stream's memory.  Specialize for T
+	// with a max_size of the most characters a value can take and a format
+	// member that writes them to first and returns the new end.  Types without
+	// one go through to_os_string
+	template<typename CharT, typename T, typename = void>
+	struct direct_converter {};
+
+	template<typename CharT, typename Integer>
+	struct direct_converter<
+	  CharT, Integer,
+	  std::enable_if_t<
+	    daw::all_true_v<std::is_integral_v<Integer>,
+	                    !std::is_same_v<bool, Integer>,
+	                    !daw::traits::is_character_v<Integer>>>> {
+		static constexpr size_t const max_size =
+		  int_string_sizes::get<sizeof( Integer )>( );
+
+		static constexpr CharT *format( CharT *first, Integer value ) noexcept {
+			return impl::format_integer( first, value );
+		}
+
+		static constexpr size_t size( Integer value ) noexcept {
+			return impl::integer_size( value );
+		}
+	};
+
+	template<typename CharT, typename Integer>
+	struct direct_converter<CharT, daw::as_int_t<Integer>>
+	  : direct_converter<CharT, daw::remove_cvref_t<Integer>> {
+		static constexpr CharT *format( CharT *first,
+		                                daw::as_int_t<Integer> value ) noexcept {
+			return impl::format_integer( first, value.value );
+		}
+
+		static constexpr size_t size( daw::as_int_t<Integer> value ) noexcept {
+			return impl::integer_size( value.value );
+		}
+	};
+
+	template<typename CharT>
+	struct direct_converter<CharT, bool> {
+		static constexpr size_t const max_size = 5;
+
+		static constexpr CharT *format( CharT *first, bool b ) noexcept {
+			char const *str = b ? "true" : "false";
+			while( *str != '\0' ) {
+				*first++ = static_cast<CharT>( *str++ );
+			}
+			return first;
+		}
+
+		static constexpr size_t size( bool b ) noexcept {
+			return b ? 4U : 5U;
+		}
+	};
+
+	template<typename CharT>
+	struct direct_converter<CharT, CharT> {
+		static constexpr size_t const max_size = 1;
+
+		static constexpr CharT *format( CharT *first, CharT c ) noexcept {
+			*first++ = c;
+			return first;
+		}
+
+		static constexpr size_t size( CharT ) noexcept {
+			return 1;
+		}
+	};
+
+	template<typename CharT, typename Float>
+	struct direct_converter<CharT, Float,
+	                        std::enable_if_t<std::is_floating_point_v<Float>>> {
+		static constexpr size_t const max_size = impl::float_buff_size<Float>;
+
+		static constexpr CharT *format( CharT *first, Float value ) noexcept {
+			return impl::format_shortest<CharT, daw::char_traits<CharT>>( first,
+			                                                              value );
+		}
+
+		static constexpr size_t size( Float value ) noexcept {
+			return impl::shortest_size<daw::char_traits<CharT>>( value );
+		}
+	};
+
+	template<typename CharT, typename Float>
+	struct direct_converter<CharT, daw::as_scientific_t<Float>> {
+		static constexpr size_t const max_size = impl::float_buff_size<Float>;
+
+		static constexpr CharT *
+		format( CharT *first, daw::as_scientific_t<Float> value ) noexcept {
+			return impl::format_shortest<CharT, daw::char_traits<CharT>,
+			                             impl::float_notation::scientific>(
+			  first, value.value );
+		}
+
+		static constexpr size_t
+		size( daw::as_scientific_t<Float> value ) noexcept {
+			return impl::shortest_size<daw::char_traits<CharT>,
+			                           impl::float_notation::scientific>(
+			  value.value );
+		}
+	};
+
+	template<typename CharT, typename Float>
+	struct direct_converter<CharT, daw::as_general_t<Float>> {
+		static constexpr size_t const max_size = impl::float_buff_size<Float>;
+
+		static constexpr CharT *format( CharT *first,
+		                                daw::as_general_t<Float> value ) noexcept {
+			return impl::format_shortest<CharT, daw::char_traits<CharT>,
+			                             impl::float_notation::general>(
+			  first, value.value );
+		}
+
+		static constexpr size_t size( daw::as_general_t<Float> value ) noexcept {
+			return impl::shortest_size<daw::char_traits<CharT>,
+			                           impl::float_notation::general>(
+			  value.value );
+		}
+	};
+
+	template<typename CharT, size_t Precision, typename Float>
+	struct direct_converter<CharT, daw::as_fixed_t<Precision, Float>> {
+		static constexpr size_t const max_size =
+		  impl::fixed_buff_size<Float> + Precision;
+
+		static constexpr CharT *
+		format( CharT *first, daw::as_fixed_t<Precision, Float> value ) noexcept {
+			return impl::format_fixed<CharT, daw::char_traits<CharT>>(
+			  first, value.value, static_cast<uint32_t>( Precision ) );
+		}
+	};
+
+	namespace impl {
+		template<typename CharT, typename T>
+		using has_direct_converter_detect =
+		  decltype( direct_converter<CharT, T>::max_size );
+	} // namespace impl
+
+	template<typename CharT, typename T>
+	constexpr bool has_direct_converter_v =
+	  daw::is_detected_v<impl::has_direct_converter_detect, CharT,
+	                     ::daw::remove_cvref_t<T>>;
+
+	namespace impl {
+		template<typename>
+		struct static_capacity {};
+
+		template<typename CharT, size_t N>
+		struct static_capacity<daw::static_string_t<CharT, N>>
+		  : std::integral_constant<size_t, N> {};
+
+		template<typename T>
+		using static_capacity_detect = decltype( static_capacity<T>::value );
+
+		template<typename CharT, typename T>
+		constexpr bool is_char_array_v =
+		  daw::all_true_v<std::is_array_v<T>,
+		                  std::is_same_v<CharT, std::remove_extent_t<T>>>;
+
+		template<typename CharT, typename T>
+		constexpr bool has_static_to_os_string_v( ) noexcept {
+			if constexpr( has_to_os_string_v<CharT, T> ) {
+				return daw::is_detected_v<
+				  static_capacity_detect,
+				  ::daw::remove_cvref_t<
+				    to_os_string_detect::has_to_os_string_detect<CharT, T>>>;
+			} else {
+				return false;
+			}
+		}
+
+		template<typename CharT, typename T>
+		constexpr bool has_max_formatted_size_v =
+		  has_direct_converter_v<CharT, T> || is_char_array_v<CharT, T> ||
+		  has_static_to_os_string_v<CharT, T>( );
+
+		template<typename CharT, typename T>
+		constexpr size_t max_formatted_size( ) noexcept {
+			static_assert( has_max_formatted_size_v<CharT, T>,
+			               "T has no maximum size, it needs a direct_converter or a "
+			               "to_os_string<CharT> that returns a static_string_t" );
+			if constexpr( has_direct_converter_v<CharT, T> ) {
+				return direct_converter<CharT, T>::max_size;
+			} else if constexpr( is_char_array_v<CharT, T> ) {
+				return std::extent_v<T> - 1U;
+			} else {
+				return static_capacity<::daw::remove_cvref_t<
+				  to_os_string_detect::has_to_os_string_detect<CharT, T>>>::value;
+			}
+		}
+	} // namespace impl
+
+	// True when every T has a compile time bound on the characters it is
+	// written as
+	template<typename CharT, typename... T>
+	constexpr bool has_max_formatted_size_v =
+	  ( impl::has_max_formatted_size_v<CharT, ::daw::remove_cvref_t<T>> && ... );
+
+	// The most characters the values of T... together are written as.  Known
+	// for types with a direct_converter, string literals and to_os_string
+	// overloads returning a static_string_t
+	template<typename CharT, typename... T>
+	inline constexpr size_t max_formatted_size_v =
+	  ( impl::max_formatted_size<CharT, ::daw::remove_cvref_t<T>>( ) + ... +
+	    0U );
+
+	namespace impl {
+		template<typename CharT, typename T>
+		using has_converter_size_detect = decltype(
+		  direct_converter<CharT, T>::size( std::declval<T const &>( ) ) );
+	} // namespace impl
+
+	// The number of characters value is written as.  Converters with a size
+	// member give it without formatting the value
+	template<typename CharT, typename T>
+	constexpr size_t formatted_size( T const &value ) {
+		using value_t = ::daw::remove_cvref_t<T>;
+		if constexpr( daw::is_detected_v<impl::has_converter_size_detect, CharT,
+		                                 value_t> ) {
+			return direct_converter<CharT, value_t>::size( value );
+		} else if constexpr( has_direct_converter_v<CharT, value_t> ) {
+			using converter_t = direct_converter<CharT, value_t>;
+			CharT buffer[converter_t::max_size]{};
+			return static_cast<size_t>( converter_t::format( buffer, value ) -
+			                            buffer );
+		} else if constexpr( daw::impl::is_string_like_v<value_t> ) {
+			return static_cast<size_t>( value.size( ) );
+		} else {
+			using ::ostream_converters::to_os_string;
+			return static_cast<size_t>( to_os_string<CharT>( value ).size( ) );
+		}
+	}
 } // namespace ostream_converters
@@ -22,6 +22,7 @@
 
 #pragma once
 
+#include <cmath>
 #include <limits>
 #include <string>
 
@@ -29,6 +30,8 @@
 #include <daw/daw_string_view.h>
 #include <daw/daw_traits.h>
 
+#include "impl/fixed_impl.h"
+#include "impl/ryu_impl.h"
 #include "ostream_converters_impl.h"
 #include "ostream_converters_int.h"
 #include "ostream_helpers.h"
@@ -36,206 +39,360 @@
 
 namespace ostream_converters {
 	namespace impl {
-#ifndef SMALL_MEMORY
-		template<
-		  typename Result, typename Int,
-		  std::enable_if_t<std::is_same_v<Result, float>, std::nullptr_t> = nullptr>
-		constexpr float pow10( Int n ) noexcept {
-			daw::exception::dbg_precondition_check( 0 <= n && n <= 38, "overflow" );
-			float const vals[20] = {1e0f,  1e2f,  1e4f,  1e6f,  1e8f,  1e10f, 1e12f,
-			                        1e14f, 1e16f, 1e18f, 1e20f, 1e22f, 1e24f, 1e26f,
-			                        1e28f, 1e30f, 1e32f, 1e34f, 1e36f, 1e38f};
-			if( n % 2 == 0 ) {
-				return vals[n / 2];
-			}
-			return vals[n / 2] * 1e1f;
-		}
-		template<typename Result, typename Int,
-		         std::enable_if_t<std::is_same_v<Result, double>, std::nullptr_t> =
-		           nullptr>
-		constexpr double pow10( Int n ) noexcept {
-			daw::exception::dbg_precondition_check( 0 <= n && n <= 308, "overflow" );
-			double const vals[155] = {
-			  1e0,   1e2,   1e4,   1e6,   1e8,   1e10,  1e12,  1e14,  1e16,  1e18,
-			  1e20,  1e22,  1e24,  1e26,  1e28,  1e30,  1e32,  1e34,  1e36,  1e38,
-			  1e40,  1e42,  1e44,  1e46,  1e48,  1e50,  1e52,  1e54,  1e56,  1e58,
-			  1e60,  1e62,  1e64,  1e66,  1e68,  1e70,  1e72,  1e74,  1e76,  1e78,
-			  1e80,  1e82,  1e84,  1e86,  1e88,  1e90,  1e92,  1e94,  1e96,  1e98,
-			  1e100, 1e102, 1e104, 1e106, 1e108, 1e110, 1e112, 1e114, 1e116, 1e118,
-			  1e120, 1e122, 1e124, 1e126, 1e128, 1e130, 1e132, 1e134, 1e136, 1e138,
-			  1e140, 1e142, 1e144, 1e146, 1e148, 1e150, 1e152, 1e154, 1e156, 1e158,
-			  1e160, 1e162, 1e164, 1e166, 1e168, 1e170, 1e172, 1e174, 1e176, 1e178,
-			  1e180, 1e182, 1e184, 1e186, 1e188, 1e190, 1e192, 1e194, 1e196, 1e198,
-			  1e200, 1e202, 1e204, 1e206, 1e208, 1e210, 1e212, 1e214, 1e216, 1e218,
-			  1e220, 1e222, 1e224, 1e226, 1e228, 1e230, 1e232, 1e234, 1e236, 1e238,
-			  1e240, 1e242, 1e244, 1e246, 1e248, 1e250, 1e252, 1e254, 1e256, 1e258,
-			  1e260, 1e262, 1e264, 1e266, 1e268, 1e270, 1e272, 1e274, 1e276, 1e278,
-			  1e280, 1e282, 1e284, 1e286, 1e288, 1e290, 1e292, 1e294, 1e296, 1e298,
-			  1e300, 1e302, 1e304, 1e306, 1e308};
-			if( n % 2 == 0 ) {
-				return vals[n / 2];
-			}
-			return vals[n / 2] * 1e1;
+		template<typename F>
+		constexpr bool is_inf( F value ) noexcept {
+			return value > std::numeric_limits<F>::max( );
+		}
+		template<typename Float>
+		constexpr bool is_nan( Float value ) noexcept {
+			return value != value;
 		}
+
+		// The sign bit, so -0.0 is negative too.  Only values below zero are in
+		// a constant expression without a bit cast
+		template<typename Float>
+		constexpr bool is_negative( Float value ) noexcept {
+#ifdef DAW_IO_HAS_BUILTIN_BIT_CAST
+			using bits_t = typename float_info<Float>::bits_t;
+			return ( __builtin_bit_cast( bits_t, value ) >>
+			         ( sizeof( bits_t ) * 8U - 1U ) ) != 0;
 #else
-		template<
-		  typename Result, typename Int,
-		  std::enable_if_t<std::is_same_v<Result, float>, std::nullptr_t> = nullptr>
-		constexpr float pow10( Int n ) noexcept {
-			daw::exception::dbg_precondition_check( n <= 38, "overflow" );
+			if( !is_constant_evaluated( ) ) {
+				return std::signbit( value );
+			}
+			return value < static_cast<Float>( 0 );
+#endif
+		}
 
-			float result = 1;
-			while( n-- > 0 ) {
-				result *= 1e1f;
+		template<typename Float>
+		inline constexpr size_t const float_buff_size =
+		  std::numeric_limits<Float>::max_digits10 + 8;
+
+		template<typename CharT>
+		constexpr CharT *copy_string( daw::basic_string_view<CharT> str,
+		                              CharT *first ) noexcept {
+			for( auto c : str ) {
+				*first++ = c;
 			}
-			return result;
+			return first;
 		}
-		template<typename Result, typename Int,
-		         std::enable_if_t<std::is_same_v<Result, double>, std::nullptr_t> =
-		           nullptr>
-		constexpr double pow10( Int n ) noexcept {
-			daw::exception::dbg_precondition_check( n <= 308, "overflow" );
-			double result = 1;
-			while( n-- > 0 ) {
-				result *= 1e1;
+
+		constexpr decimal_fp remove_trailing_zeros( decimal_fp v ) noexcept {
+			while( v.mantissa >= 10U && v.mantissa % 10U == 0 ) {
+				v.mantissa /= 10U;
+				++v.exponent;
 			}
-			return result;
+			return v;
 		}
-#endif
 
-		template<typename F>
-		constexpr bool is_inf( F value ) noexcept {
-			return value > std::numeric_limits<F>::max( );
+		// d.ddde-x, digits is the number of digits in v.mantissa
+		template<typename Traits, typename CharT>
+		constexpr CharT *format_scientific( CharT *first, decimal_fp v,
+		                                    int32_t digits ) noexcept {
+			auto const sci_exponent = digits + v.exponent - 1;
+			// Write the digits one past where they go and move the first back to
+			// make room for the decimal point
+			CharT *last = format_unsigned( first + 1, v.mantissa );
+			first[0] = first[1];
+			if( digits > 1 ) {
+				first[1] = Traits::decimal_point;
+			} else {
+				last = first + 1;
+			}
+			*last++ = static_cast<CharT>( 'e' );
+			if( sci_exponent < 0 ) {
+				*last++ = static_cast<CharT>( '-' );
+			}
+			return format_unsigned(
+			  last, static_cast<uint32_t>( sci_exponent < 0 ? -sci_exponent
+			                                                : sci_exponent ) );
+		}
+
+		// ddd000, ddd.ddd or 0.000ddd.  digits is the number of digits in
+		// v.mantissa
+		template<typename Traits, typename CharT>
+		constexpr CharT *format_fixed_notation( CharT *first, decimal_fp v,
+		                                        int32_t digits ) noexcept {
+			auto const sci_exponent = digits + v.exponent - 1;
+			if( sci_exponent < 0 ) {
+				*first++ = Traits::get_char_digit( 0 );
+				*first++ = Traits::decimal_point;
+				for( int32_t n = sci_exponent + 1; n < 0; ++n ) {
+					*first++ = Traits::get_char_digit( 0 );
+				}
+				return format_unsigned( first, v.mantissa );
+			}
+			if( v.exponent >= 0 ) {
+				first = format_unsigned( first, v.mantissa );
+				for( int32_t n = 0; n < v.exponent; ++n ) {
+					*first++ = Traits::get_char_digit( 0 );
+				}
+				return first;
+			}
+			CharT *const last = format_unsigned( first + 1, v.mantissa );
+			for( int32_t n = 0; n <= sci_exponent; ++n ) {
+				first[n] = first[n + 1];
+			}
+			first[sci_exponent + 1] = Traits::decimal_point;
+			return last;
+		}
+
+		// The length of format_scientific's output
+		constexpr int32_t scientific_size( decimal_fp v, int32_t digits ) noexcept {
+			auto const sci_exponent = digits + v.exponent - 1;
+			auto const abs_exponent = static_cast<uint32_t>(
+			  sci_exponent < 0 ? -sci_exponent : sci_exponent );
+			return digits + ( digits > 1 ? 2 : 1 ) + ( sci_exponent < 0 ? 1 : 0 ) +
+			       static_cast<int32_t>( count_digits( abs_exponent ) );
+		}
+
+		// The length of format_fixed_notation's output
+		constexpr int32_t fixed_notation_size( decimal_fp v,
+		                                       int32_t digits ) noexcept {
+			auto const sci_exponent = digits + v.exponent - 1;
+			if( sci_exponent < 0 ) {
+				return 1 - sci_exponent + digits;
+			}
+			return v.exponent >= 0 ? digits + v.exponent : digits + 1;
+		}
+
+		enum class float_notation { automatic, scientific, general };
+
+		// automatic uses fixed notation when the magnitude allows for it without
+		// padding it past max_digits10 digits.  general uses whichever of fixed
+		// or scientific is shorter, preferring fixed
+		template<typename Float, float_notation Notation>
+		constexpr bool use_scientific( decimal_fp v, int32_t digits ) noexcept {
+			auto const sci_exponent = digits + v.exponent - 1;
+			if constexpr( Notation == float_notation::automatic ) {
+				return sci_exponent < -5 ||
+				       sci_exponent >= std::numeric_limits<Float>::max_digits10;
+			} else if constexpr( Notation == float_notation::general ) {
+				return fixed_notation_size( v, digits ) > scientific_size( v, digits );
+			} else {
+				return true;
+			}
+		}
+
+		template<typename Float, float_notation Notation, typename Traits,
+		         typename CharT>
+		constexpr CharT *format_decimal( CharT *first, decimal_fp v ) noexcept {
+			v = remove_trailing_zeros( v );
+			auto const digits = static_cast<int32_t>( count_digits( v.mantissa ) );
+			if( use_scientific<Float, Notation>( v, digits ) ) {
+				return format_scientific<Traits>( first, v, digits );
+			}
+			return format_fixed_notation<Traits>( first, v, digits );
+		}
+
+		// The length of format_decimal's output
+		template<typename Float, float_notation Notation>
+		constexpr size_t decimal_size( decimal_fp v ) noexcept {
+			v = remove_trailing_zeros( v );
+			auto const digits = static_cast<int32_t>( count_digits( v.mantissa ) );
+			if( use_scientific<Float, Notation>( v, digits ) ) {
+				return static_cast<size_t>( scientific_size( v, digits ) );
+			}
+			return static_cast<size_t>( fixed_notation_size( v, digits ) );
 		}
+
+		template<typename CharT, typename Traits,
+		         float_notation Notation = float_notation::automatic,
+		         typename Float>
+		constexpr CharT *format_shortest( CharT *first, Float value ) noexcept {
+			if( is_nan( value ) ) {
+				return copy_string( Traits::nan( ), first );
+			}
+			// Like printf, -0.0 keeps its sign
+			if( is_negative( value ) ) {
+				*first++ = static_cast<CharT>( '-' );
+				value = -value;
+			}
+			if( is_inf( value ) ) {
+				return copy_string( Traits::inf( ), first );
+			}
+			if( value == static_cast<Float>( 0 ) ) {
+				return format_decimal<Float, Notation, Traits>( first,
+				                                                decimal_fp{0, 0} );
+			}
+			return format_decimal<Float, Notation, Traits>(
+			  first, to_shortest_decimal<Float>( decompose( value ) ) );
+		}
+
+		// The length of format_shortest's output without writing it
+		template<typename Traits, float_notation Notation = float_notation::automatic,
+		         typename Float>
+		constexpr size_t shortest_size( Float value ) noexcept {
+			if( is_nan( value ) ) {
+				return Traits::nan( ).size( );
+			}
+			size_t sign = 0;
+			if( is_negative( value ) ) {
+				sign = 1;
+				value = -value;
+			}
+			if( is_inf( value ) ) {
+				return sign + Traits::inf( ).size( );
+			}
+			if( value == static_cast<Float>( 0 ) ) {
+				return sign + decimal_size<Float, Notation>( decimal_fp{0, 0} );
+			}
+			return sign + decimal_size<Float, Notation>(
+			                to_shortest_decimal<Float>( decompose( value ) ) );
+		}
+
+		// Sign, decimal point and the longest whole part
 		template<typename Float>
-		constexpr bool is_nan( Float value ) noexcept {
-			return value != value;
+		inline constexpr size_t const fixed_buff_size =
+		  static_cast<size_t>( std::numeric_limits<Float>::max_exponent10 ) + 3U;
+
+		// The most digits after the decimal point that significant_digits can
+		// ask for, as needed by the smallest denormal
+		template<typename Float>
+		inline constexpr int const max_fixed_fraction =
+		  2 * std::numeric_limits<Float>::max_digits10 -
+		  std::numeric_limits<Float>::min_exponent10;
+
+		// When there are digits after the decimal point there are at most
+		// max_digits10 before it
+		template<typename Float>
+		inline constexpr size_t const limited_fixed_buff_size =
+		  2U + daw::max( static_cast<size_t>(
+		                   std::numeric_limits<Float>::max_exponent10 + 1 ),
+		                 static_cast<size_t>(
+		                   std::numeric_limits<Float>::max_digits10 + 1 +
+		                   max_fixed_fraction<Float> ) );
+
+		template<typename CharT, typename Traits, typename Float>
+		constexpr CharT *format_fixed( CharT *first, Float value,
+		                               uint32_t precision ) noexcept {
+			if( is_nan( value ) ) {
+				return copy_string( Traits::nan( ), first );
+			}
+			// Like printf, -0.0 keeps its sign
+			if( is_negative( value ) ) {
+				*first++ = static_cast<CharT>( '-' );
+				value = -value;
+			}
+			if( is_inf( value ) ) {
+				return copy_string( Traits::inf( ), first );
+			}
+			if( value == static_cast<Float>( 0 ) ) {
+				return format_fixed_digits<CharT, Traits>( first, binary_fp{0, 0},
+				                                           precision );
+			}
+			return format_fixed_digits<CharT, Traits>(
+			  first, to_binary_fp<Float>( decompose( value ) ), precision );
 		}
 
+		// The digits after the decimal point that keep the output within
+		// significant_digits, but no more than precision
 		template<typename Float>
-		constexpr static int max_fractional_digits =
-		  std::numeric_limits<Float>::min_exponent10 * -1;
+		constexpr uint32_t limited_fraction_digits( Float value,
+		                                            int significant_digits,
+		                                            int precision ) noexcept {
+			if( is_nan( value ) || value == static_cast<Float>( 0 ) ) {
+				return 0;
+			}
+			if( value < static_cast<Float>( 0 ) ) {
+				value = -value;
+			}
+			if( is_inf( value ) ) {
+				return 0;
+			}
+			auto const digits = daw::min( daw::max( significant_digits, 1 ),
+			                              std::numeric_limits<Float>::max_digits10 );
+			auto const d = to_shortest_decimal<Float>( decompose( value ) );
+			auto const sci_exponent =
+			  static_cast<int>( count_digits( d.mantissa ) ) + d.exponent - 1;
+			auto const result = daw::min(
+			  digits - 1 - sci_exponent,
+			  daw::min( precision, max_fixed_fraction<Float> ) );
+			return result < 0 ? 0U : static_cast<uint32_t>( result );
+		}
 	} // namespace impl
 
-	// Floating point numbers
+	// Floating point numbers.  Outputs the fewest digits that will read back as
+	// the same value
 	template<
 	  typename CharT, typename Float, typename Traits = daw::char_traits<CharT>,
 	  std::enable_if_t<std::is_floating_point_v<Float>, std::nullptr_t> = nullptr>
-	constexpr auto to_os_string(
-	  Float value,
-	  int significant_digits = std::numeric_limits<Float>::max_digits10,
-	  int precision = std::numeric_limits<Float>::max_digits10 ) {
-		auto const min_value = std::numeric_limits<Float>::is_iec559
-		                         ? std::numeric_limits<Float>::denorm_min( )
-		                         : std::numeric_limits<Float>::min( );
-
-		size_t const buff_size = std::numeric_limits<Float>::max_digits10 + 8;
-
-		daw::static_string_t<CharT, buff_size> result{};
-
-		if( ( value == static_cast<Float>( 0 ) && value != min_value ) ||
-		    ( value == static_cast<Float>( -0.0 ) && value != -min_value ) ) {
-
-			result += Traits::get_char_digit( 0 );
-			return result;
-		}
-		if( impl::is_nan( value ) ) {
-			result += Traits::nan( );
-			return result;
-		}
-		if( value < 0 ) {
-			result += static_cast<CharT>( '-' );
-			value = -value;
-		}
-		if( impl::is_inf( value ) ) {
-			result += Traits::inf( );
-			return result;
-		}
-
-		// Whole numbers
-		auto const e = impl::whole_log10<uint16_t>( value );
-		auto tmp_value = value;
-
-		auto const max_dig = static_cast<int16_t>(
-		  daw::max( 0, static_cast<int>( e ) -
-		                 daw::min( std::numeric_limits<Float>::max_digits10,
-		                           significant_digits ) ) );
-
-		for( int ex = e; ex >= max_dig; --ex ) {
-			auto const p10 = impl::pow10<Float>( ex );
-			auto const digit = static_cast<char>( tmp_value / p10 );
-
-			daw::exception::dbg_precondition_check<impl::unexpected_state>(
-			  digit >= 0 && digit <= 10 );
-
-			result += Traits::get_char_digit( digit );
-
-			tmp_value -= static_cast<Float>( digit ) * p10;
-		}
-		for( int16_t ex = max_dig; ex > 0; --ex ) {
-			result += Traits::get_char_digit( 0 );
-			result += result.back( );
-			for( size_t n = result.size( ) - 2; n > 0; --n ) {
-				result[n] = result[n - 1];
-			}
-			result[1] = Traits::decimal_point;
-			result += 'e';
-			result += to_os_string<CharT>( e );
-			return result;
-		}
-		if( e >= std::numeric_limits<Float>::max_digits10 ||
-		    e >= significant_digits || tmp_value < min_value ) {
-			return result;
-		}
-		// Fractional Part
-		intmax_t neg_exp = -1;
-		result += Traits::decimal_point;
-		if( e == 0 && value < static_cast<Float>( 1 ) && value >= min_value ) {
-			neg_exp = 0;
-			// We have no significant digits previously.
-			// Output zeros
-			auto digit = static_cast<char>( tmp_value * static_cast<Float>( 10 ) );
-			while( digit == 0 ) {
-				++neg_exp;
-				tmp_value *= static_cast<Float>( 10 );
-				digit = static_cast<char>( tmp_value * static_cast<Float>( 10 ) );
-			}
-			if( neg_exp > 3 && result.size( ) > 0 ) {
-				if( result[0] == static_cast<CharT>( '-' ) ) {
-					result.resize( 1, false );
-				} else {
-					result.resize( 0, false );
-				}
-				result += Traits::get_char_digit( digit );
-				tmp_value *= static_cast<Float>( 10 );
-				tmp_value -= static_cast<Float>( digit );
-				result += Traits::decimal_point;
-			} else {
-				neg_exp = -1;
-			}
-		}
+	constexpr auto to_os_string( Float value ) {
+		daw::static_string_t<CharT, impl::float_buff_size<Float>> result{};
+		CharT *const last =
+		  impl::format_shortest<CharT, Traits>( result.data( ), value );
+		result.resize( static_cast<size_t>( last - result.data( ) ), false );
+		return result;
+	}
 
-		auto const num_dec_digits =
-		  daw::min( daw::min( precision, impl::max_fractional_digits<Float> ),
-		            std::numeric_limits<Float>::max_digits10 - e );
+	// Floating point numbers as d.ddde-x with the fewest digits that will read
+	// back as the same value
+	template<typename CharT, typename Float,
+	         typename Traits = daw::char_traits<CharT>>
+	constexpr auto to_os_string( daw::as_scientific_t<Float> value ) {
+		static_assert( std::is_floating_point_v<Float>,
+		               "as_scientific requires a floating point number" );
+		daw::static_string_t<CharT, impl::float_buff_size<Float>> result{};
+		CharT *const last =
+		  impl::format_shortest<CharT, Traits, impl::float_notation::scientific>(
+		    result.data( ), value.value );
+		result.resize( static_cast<size_t>( last - result.data( ) ), false );
+		return result;
+	}
 
-		for( int n = 0; n < num_dec_digits && tmp_value >= min_value; ++n ) {
-			auto const digit =
-			  static_cast<char>( tmp_value * static_cast<Float>( 10 ) );
+	// Floating point numbers with the fewest digits that will read back as the
+	// same value, in fixed or scientific notation whichever is shorter
+	template<typename CharT, typename Float,
+	         typename Traits = daw::char_traits<CharT>>
+	constexpr auto to_os_string( daw::as_general_t<Float> value ) {
+		static_assert( std::is_floating_point_v<Float>,
+		               "as_general requires a floating point number" );
+		daw::static_string_t<CharT, impl::float_buff_size<Float>> result{};
+		CharT *const last =
+		  impl::format_shortest<CharT, Traits, impl::float_notation::general>(
+		    result.data( ), value.value );
+		result.resize( static_cast<size_t>( last - result.data( ) ), false );
+		return result;
+	}
 
-			result += Traits::get_char_digit( digit );
-			tmp_value -= static_cast<Float>( digit ) / static_cast<Float>( 10 );
-			tmp_value *= static_cast<Float>( 10 );
-		}
-		while( result[result.size( ) - 2] != Traits::decimal_point &&
-		       result.back( ) == Traits::get_char_digit( 0 ) ) {
-			result.resize( result.size( ) - 1, false );
-		}
-		if( neg_exp >= 0 ) {
-			result += static_cast<CharT>( 'e' );
-			result += static_cast<CharT>( '-' );
-			result += to_os_string<CharT>( neg_exp + 1 );
+	// Floating point numbers in fixed notation with exactly Precision digits
+	// after the decimal point, rounded half to even like printf's %.Nf
+	template<typename CharT, size_t Precision, typename Float,
+	         typename Traits = daw::char_traits<CharT>>
+	constexpr auto to_os_string( daw::as_fixed_t<Precision, Float> value ) {
+		static_assert( std::is_floating_point_v<Float>,
+		               "as_fixed requires a floating point number" );
+		daw::static_string_t<CharT, impl::fixed_buff_size<Float> + Precision>
+		  result{};
+		CharT *const last = impl::format_fixed<CharT, Traits>(
+		  result.data( ), value.value, static_cast<uint32_t>( Precision ) );
+		result.resize( static_cast<size_t>( last - result.data( ) ), false );
+		return result;
+	}
+
+	// Floating point numbers in fixed notation limited to significant_digits in
+	// total and precision digits after the decimal point.  The whole part is
+	// always output in full and trailing zeros are dropped
+	template<
+	  typename CharT, typename Float, typename Traits = daw::char_traits<CharT>,
+	  std::enable_if_t<std::is_floating_point_v<Float>, std::nullptr_t> = nullptr>
+	constexpr auto
+	to_os_string( Float value, int significant_digits,
+	              int precision = std::numeric_limits<Float>::max_digits10 ) {
+		daw::static_string_t<CharT, impl::limited_fixed_buff_size<Float>> result{};
+		auto const fraction_digits =
+		  impl::limited_fraction_digits( value, significant_digits, precision );
+		CharT *last = impl::format_fixed<CharT, Traits>( result.data( ), value,
+		                                                 fraction_digits );
+		if( fraction_digits > 0 ) {
+			while( *( last - 1 ) == Traits::get_char_digit( 0 ) ) {
+				--last;
+			}
+			if( *( last - 1 ) == Traits::decimal_point ) {
+				--last;
+			}
 		}
+		result.resize( static_cast<size_t>( last - result.data( ) ), false );
 		return result;
-	} // namespace ostream_converters
+	}
 } // namespace ostream_converters
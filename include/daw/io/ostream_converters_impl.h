@@ -22,23 +22,88 @@
 
 #pragma once
 
+#include <cstdint>
+
 #include <daw/cpp_17.h>
 #include <daw/daw_traits.h>
 
 #include "ostream_helpers.h"
 
+#if defined( __has_builtin )
+#if __has_builtin( __builtin_is_constant_evaluated )
+#define DAW_IO_HAS_IS_CONSTANT_EVALUATED
+#endif
+#elif defined( __GNUC__ ) && __GNUC__ >= 9
+#define DAW_IO_HAS_IS_CONSTANT_EVALUATED
+#endif
+
 namespace ostream_converters {
 	namespace impl {
-		template<
-		  typename Result, typename Number,
-		  std::enable_if_t<std::is_arithmetic_v<Number>, std::nullptr_t> = nullptr>
-		constexpr uint16_t whole_log10( Number positive_value ) noexcept {
-			Result result = 0;
-			while( positive_value >= 10 ) {
-				++result;
-				positive_value /= static_cast<Number>( 10 );
+		// Without compiler support there is no way to tell, so always take the
+		// constexpr path
+		constexpr bool is_constant_evaluated( ) noexcept {
+#ifdef DAW_IO_HAS_IS_CONSTANT_EVALUATED
+			return __builtin_is_constant_evaluated( );
+#else
+			return true;
+#endif
+		}
+
+		inline constexpr uint64_t const powers_of_ten[20] = {
+		  1ULL,
+		  10ULL,
+		  100ULL,
+		  1000ULL,
+		  10000ULL,
+		  100000ULL,
+		  1000000ULL,
+		  10000000ULL,
+		  100000000ULL,
+		  1000000000ULL,
+		  10000000000ULL,
+		  100000000000ULL,
+		  1000000000000ULL,
+		  10000000000000ULL,
+		  100000000000000ULL,
+		  1000000000000000ULL,
+		  10000000000000000ULL,
+		  100000000000000000ULL,
+		  1000000000000000000ULL,
+		  10000000000000000000ULL};
+
+		// Number of bits needed to represent value, with 0 needing 1 bit
+		constexpr uint32_t bit_width( uint64_t value ) noexcept {
+#if defined( __GNUC__ ) || defined( __clang__ )
+			return 64U - static_cast<uint32_t>( __builtin_clzll( value | 1ULL ) );
+#else
+			uint32_t result = 1;
+			for( uint32_t shift = 32; shift > 0; shift /= 2 ) {
+				if( ( value >> shift ) != 0 ) {
+					value >>= shift;
+					result += shift;
+				}
 			}
 			return result;
+#endif
+		}
+
+		// Number of decimal digits in value.  The bit width gives an estimate of
+		// log10 via 1233/4096 ~= log10( 2 ) that is at most one less than the
+		// answer, a single table comparison corrects it.  Setting the low bit
+		// handles 0 and never moves a value across a power of ten
+		constexpr uint16_t count_digits( uint64_t value ) noexcept {
+			value |= 1ULL;
+			auto const t = ( bit_width( value ) * 1233U ) >> 12U;
+			return static_cast<uint16_t>( t +
+			                              ( value >= powers_of_ten[t] ? 1U : 0U ) );
+		}
+
+		template<typename Result, typename Number,
+		         std::enable_if_t<std::is_integral_v<Number>, std::nullptr_t> =
+		           nullptr>
+		constexpr Result whole_log10( Number positive_value ) noexcept {
+			return static_cast<Result>(
+			  count_digits( static_cast<uint64_t>( positive_value ) ) - 1U );
 		}
 		struct unexpected_state {};
 	} // namespace impl
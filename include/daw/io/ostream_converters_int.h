@@ -37,35 +37,57 @@ namespace ostream_converters {
 		constexpr Result num_digits( T value ) noexcept {
 			static_assert( std::is_integral_v<Result>,
 			               "Result must be an integer type" );
-			if( value == 0 ) {
-				return static_cast<Result>( 1 );
+			using unsigned_t = std::make_unsigned_t<daw::remove_cvref_t<T>>;
+			auto uvalue = static_cast<unsigned_t>( value );
+			if constexpr( std::is_signed_v<daw::remove_cvref_t<T>> ) {
+				if( value < 0 ) {
+					uvalue = static_cast<unsigned_t>( 0 ) - uvalue;
+				}
 			}
-			Result result = 0;
-			while( value != 0 ) {
-				value /= 10;
-				++result;
+			return static_cast<Result>(
+			  count_digits( static_cast<uint64_t>( uvalue ) ) );
+		}
+
+		// The two digit strings for 00 through 99, in order.  Looking up a pair
+		// lets us halve the number of divisions needed per number
+		inline constexpr char const digit_pairs[201] =
+		  "0001020304050607080910111213141516171819"
+		  "2021222324252627282930313233343536373839"
+		  "4041424344454647484950515253545556575859"
+		  "6061626364656667686970717273747576777879"
+		  "8081828384858687888990919293949596979899";
+
+		// The unsigned type used to do the conversion arithmetic in.  Smaller
+		// types are promoted as the math is no cheaper for them
+		template<typename Integer>
+		using unsigned_work_t =
+		  std::conditional_t<( sizeof( Integer ) <= sizeof( uint32_t ) ),
+		                     uint32_t, uint64_t>;
+
+		// Write the decimal digits of value to first and return the position
+		// after the last digit written
+		template<typename CharT, typename Unsigned>
+		constexpr CharT *format_unsigned( CharT *first, Unsigned value ) noexcept {
+			static_assert( std::is_unsigned_v<Unsigned>,
+			               "Only unsigned values are supported" );
+
+			CharT *const last = first + count_digits( value );
+			CharT *ptr = last;
+
+			while( value >= 100U ) {
+				auto const idx = static_cast<size_t>( value % 100U ) * 2U;
+				value /= 100U;
+				*--ptr = static_cast<CharT>( digit_pairs[idx + 1] );
+				*--ptr = static_cast<CharT>( digit_pairs[idx] );
 			}
-			return result;
-		}
-
-		template<
-		  typename Result, typename Integer,
-		  std::enable_if_t<std::is_integral_v<Result>, std::nullptr_t> = nullptr>
-		constexpr Result pow10( Integer n ) noexcept {
-			uint64_t const vals[10] = {1ULL,
-			                           100ULL,
-			                           10000ULL,
-			                           1000000ULL,
-			                           100000000ULL,
-			                           10000000000ULL,
-			                           1000000000000ULL,
-			                           100000000000000ULL,
-			                           10000000000000000ULL,
-			                           1000000000000000000ULL};
-			if( n % 2 == 0 ) {
-				return static_cast<Result>( vals[n / 2] );
+			if( value >= 10U ) {
+				auto const idx = static_cast<size_t>( value ) * 2U;
+				*--ptr = static_cast<CharT>( digit_pairs[idx + 1] );
+				*--ptr = static_cast<CharT>( digit_pairs[idx] );
+			} else {
+				*--ptr = static_cast<CharT>( '0' + static_cast<char>( value ) );
 			}
-			return static_cast<Result>( vals[n / 2] * 10ULL );
+			return last;
 		}
 	} // namespace impl
 
@@ -95,48 +117,35 @@ namespace ostream_converters {
 			return 21;
 		}
 	} // namespace int_string_sizes
-	namespace min_strings {
-		constexpr auto get( char, std::integral_constant<size_t, 1> ) noexcept {
-			return daw::static_string_t<char, int_string_sizes::get<1>( )>( "-128" );
-		}
-
-		constexpr auto get( wchar_t, std::integral_constant<size_t, 1> ) noexcept {
-			return daw::static_string_t<wchar_t, int_string_sizes::get<1>( )>(
-			  L"-128" );
-		}
 
-		constexpr auto get( char, std::integral_constant<size_t, 2> ) noexcept {
-			return daw::static_string_t<char, int_string_sizes::get<2>( )>(
-			  "-32768" );
-		}
-
-		constexpr auto get( wchar_t, std::integral_constant<size_t, 2> ) noexcept {
-			return daw::static_string_t<wchar_t, int_string_sizes::get<2>( )>(
-			  L"-32768" );
-		}
-
-		constexpr auto get( char, std::integral_constant<size_t, 4> ) noexcept {
-			return daw::static_string_t<char, int_string_sizes::get<4>( )>(
-			  "-2147483648" );
-		}
-
-		constexpr auto get( wchar_t, std::integral_constant<size_t, 4> ) noexcept {
-			return daw::static_string_t<wchar_t, int_string_sizes::get<4>( )>(
-			  L"-2147483648" );
-		}
-
-		constexpr auto get( char, std::integral_constant<size_t, 8> ) noexcept {
-			return daw::static_string_t<char, int_string_sizes::get<8>( )>(
-			  "-9223372036854775808" );
+	namespace impl {
+		// Write value to first, there must be room for
+		// int_string_sizes::get<sizeof( Integer )>( ) characters
+		template<typename CharT, typename Integer>
+		constexpr CharT *format_integer( CharT *first, Integer value ) noexcept {
+			using unsigned_t = unsigned_work_t<Integer>;
+			auto uvalue = static_cast<unsigned_t>( value );
+			if constexpr( std::is_signed_v<Integer> ) {
+				if( value < 0 ) {
+					*first++ = static_cast<CharT>( '-' );
+					// Negating in the unsigned type is well defined for min( )
+					uvalue = static_cast<unsigned_t>( 0 ) - uvalue;
+				}
+			}
+			return format_unsigned( first, uvalue );
 		}
 
-		constexpr auto get( wchar_t, std::integral_constant<size_t, 8> ) noexcept {
-			return daw::static_string_t<wchar_t, int_string_sizes::get<8>( )>(
-			  L"-9223372036854775808" );
+		// The length of format_integer's output
+		template<typename Integer>
+		constexpr size_t integer_size( Integer value ) noexcept {
+			if constexpr( std::is_signed_v<Integer> ) {
+				if( value < 0 ) {
+					return 1U + num_digits<Integer, size_t>( value );
+				}
+			}
+			return num_digits<Integer, size_t>( value );
 		}
-	} // namespace min_strings
 
-	namespace impl {
 		// Integer numbers
 		template<
 		  typename CharT, typename Integer,
@@ -151,28 +160,8 @@ namespace ostream_converters {
 			daw::static_string_t<CharT, int_string_sizes::get<sizeof( Integer )>( )>
 			  result{};
 
-			if( value < 0 ) {
-				if( value == std::numeric_limits<Integer>::min( ) ) {
-					return min_strings::get(
-					  CharT{}, std::integral_constant<size_t, sizeof( Integer )>{} );
-				}
-				result += static_cast<CharT>( '-' );
-				value = -value;
-			}
-			for( auto pow10 =
-			       impl::pow10<Integer>( impl::whole_log10<uint16_t>( value ) );
-			     pow10 >= 1; pow10 /= static_cast<Integer>( 10 ) ) {
-
-				auto const tmp = value / pow10;
-
-				daw::exception::dbg_precondition_check(
-				  tmp >= 0 && tmp < 10,
-				  "There should only ever be a single digit positive number" );
-
-				result += Traits::get_char_digit( tmp );
-
-				value -= tmp * pow10;
-			}
+			CharT *const ptr = format_integer( result.data( ), value );
+			result.resize( static_cast<size_t>( ptr - result.data( ) ), false );
 			return result;
 		}
 	} // namespace impl
@@ -0,0 +1,247 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2019 Darrell Wright
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files( the "Software" ), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and / or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <daw/daw_string_view.h>
+
+#include "ostream_converters_impl.h"
+#include "ostream_converters_int.h"
+
+#if( defined( __x86_64__ ) || defined( __i386__ ) ) &&                        \
+  ( defined( __GNUC__ ) || defined( __clang__ ) ) && defined( __SSE2__ )
+#define DAW_IO_HAS_X86_SIMD
+#include <immintrin.h>
+#endif
+
+// Batches of 32 and 64 bit integers to decimal, converting the low 8 digit
+// groups of several values at once with SSE2 or AVX2.  The approach is that of
+// Wojciech Mula's and Milo Yip's SSE2 itoa, the digits of abcdefgh are found by
+// dividing [abcd, abcd, abcd, abcd, efgh, efgh, efgh, efgh] by
+// [1000, 100, 10, 1] with multiply high and subtracting the digits above
+namespace ostream_converters {
+	namespace impl {
+		namespace simd {
+			// Write the 8 digits, with leading zeros, of 4 values below 10^8 to out
+			using digits8x4_t = void ( * )( uint32_t const *values, char *out );
+
+			inline void digits8x4_scalar( uint32_t const *values,
+			                              char *out ) noexcept {
+				for( size_t n = 0; n < 4; ++n ) {
+					auto value = values[n];
+					for( size_t i = 8; i > 0; i -= 2 ) {
+						auto const idx = static_cast<size_t>( value % 100U ) * 2U;
+						value /= 100U;
+						out[n * 8 + i - 1] = digit_pairs[idx + 1];
+						out[n * 8 + i - 2] = digit_pairs[idx];
+					}
+				}
+			}
+
+#ifdef DAW_IO_HAS_X86_SIMD
+			// abcd * 4 and efgh * 4 divided by 10^3, 10^2, 10^1 and 10^0 in two
+			// multiply high steps
+			inline constexpr uint16_t const div_powers[8] = {
+			  8389, 5243, 13108, 32768, 8389, 5243, 13108, 32768};
+			inline constexpr uint16_t const shift_powers[8] = {
+			  1U << 7U,  1U << 11U, 1U << 13U, 1U << 15U,
+			  1U << 7U,  1U << 11U, 1U << 13U, 1U << 15U};
+			// ceil( 2^45 / 10^4 )
+			inline constexpr uint32_t const div_10000 = 0xd1b7'1759U;
+
+			// 8 unsigned 16 bit lanes holding the digits of value < 10^8
+			inline __m128i convert_8digits_sse2( uint32_t value ) noexcept {
+				auto const abcdefgh = _mm_cvtsi32_si128( static_cast<int>( value ) );
+				auto const abcd = _mm_srli_epi64(
+				  _mm_mul_epu32( abcdefgh, _mm_set1_epi32( static_cast<int>( div_10000 ) ) ),
+				  45 );
+				auto const efgh = _mm_sub_epi32(
+				  abcdefgh, _mm_mul_epu32( abcd, _mm_set1_epi32( 10000 ) ) );
+				auto const v1 = _mm_slli_epi64( _mm_unpacklo_epi16( abcd, efgh ), 2 );
+				auto const v2a = _mm_unpacklo_epi16( v1, v1 );
+				auto const v2 = _mm_unpacklo_epi32( v2a, v2a );
+				auto const v3 = _mm_mulhi_epu16(
+				  v2, _mm_loadu_si128( reinterpret_cast<__m128i const *>( div_powers ) ) );
+				auto const v4 = _mm_mulhi_epu16(
+				  v3,
+				  _mm_loadu_si128( reinterpret_cast<__m128i const *>( shift_powers ) ) );
+				auto const v5 = _mm_mullo_epi16( v4, _mm_set1_epi16( 10 ) );
+				auto const v6 = _mm_slli_epi64( v5, 16 );
+				return _mm_sub_epi16( v4, v6 );
+			}
+
+			// Two values per vector once the 16 bit digits are packed to bytes
+			inline void digits8x4_sse2( uint32_t const *values, char *out ) noexcept {
+				auto const zero = _mm_set1_epi8( '0' );
+				auto const ab = _mm_packus_epi16( convert_8digits_sse2( values[0] ),
+				                                  convert_8digits_sse2( values[1] ) );
+				auto const cd = _mm_packus_epi16( convert_8digits_sse2( values[2] ),
+				                                  convert_8digits_sse2( values[3] ) );
+				_mm_storeu_si128( reinterpret_cast<__m128i *>( out ),
+				                  _mm_add_epi8( ab, zero ) );
+				_mm_storeu_si128( reinterpret_cast<__m128i *>( out + 16 ),
+				                  _mm_add_epi8( cd, zero ) );
+			}
+
+			// The same steps as convert_8digits_sse2 on two values at once, one in
+			// each 128 bit lane
+			__attribute__( ( target( "avx2" ) ) ) inline __m256i
+			convert_8digits_avx2( uint32_t lo, uint32_t hi ) noexcept {
+				auto const abcdefgh = _mm256_setr_epi32(
+				  static_cast<int>( lo ), 0, 0, 0, static_cast<int>( hi ), 0, 0, 0 );
+				auto const abcd = _mm256_srli_epi64(
+				  _mm256_mul_epu32( abcdefgh,
+				                    _mm256_set1_epi32( static_cast<int>( div_10000 ) ) ),
+				  45 );
+				auto const efgh = _mm256_sub_epi32(
+				  abcdefgh, _mm256_mul_epu32( abcd, _mm256_set1_epi32( 10000 ) ) );
+				auto const v1 =
+				  _mm256_slli_epi64( _mm256_unpacklo_epi16( abcd, efgh ), 2 );
+				auto const v2a = _mm256_unpacklo_epi16( v1, v1 );
+				auto const v2 = _mm256_unpacklo_epi32( v2a, v2a );
+				auto const powers = _mm_loadu_si128(
+				  reinterpret_cast<__m128i const *>( div_powers ) );
+				auto const shifts = _mm_loadu_si128(
+				  reinterpret_cast<__m128i const *>( shift_powers ) );
+				auto const v3 =
+				  _mm256_mulhi_epu16( v2, _mm256_set_m128i( powers, powers ) );
+				auto const v4 =
+				  _mm256_mulhi_epu16( v3, _mm256_set_m128i( shifts, shifts ) );
+				auto const v5 = _mm256_mullo_epi16( v4, _mm256_set1_epi16( 10 ) );
+				auto const v6 = _mm256_slli_epi64( v5, 16 );
+				return _mm256_sub_epi16( v4, v6 );
+			}
+
+			// Four values per vector
+			__attribute__( ( target( "avx2" ) ) ) inline void
+			digits8x4_avx2( uint32_t const *values, char *out ) noexcept {
+				auto const ab = convert_8digits_avx2( values[0], values[1] );
+				auto const cd = convert_8digits_avx2( values[2], values[3] );
+				// Packing works per lane, giving a c | b d
+				auto const acbd = _mm256_packus_epi16( ab, cd );
+				auto const abcd = _mm256_permute4x64_epi64( acbd, 0b11'01'10'00 );
+				_mm256_storeu_si256( reinterpret_cast<__m256i *>( out ),
+				                     _mm256_add_epi8( abcd, _mm256_set1_epi8( '0' ) ) );
+			}
+#endif
+
+			inline digits8x4_t select_digits8x4( ) noexcept {
+#ifdef DAW_IO_HAS_X86_SIMD
+				__builtin_cpu_init( );
+				if( __builtin_cpu_supports( "avx2" ) ) {
+					return digits8x4_avx2;
+				}
+				return digits8x4_sse2;
+#else
+				return digits8x4_scalar;
+#endif
+			}
+
+			// Chosen once for the CPU we are running on
+			inline void digits8x4( uint32_t const *values, char *out ) noexcept {
+				static digits8x4_t const kernel = select_digits8x4( );
+				kernel( values, out );
+			}
+		} // namespace simd
+
+		template<typename Integer>
+		inline constexpr bool has_integer_batch_v =
+		  std::is_integral_v<Integer> &&
+		  ( sizeof( Integer ) == 4 || sizeof( Integer ) == 8 );
+
+		// 4 32 bit values or 2 64 bit values fill the 4 digit groups of a batch
+		template<typename Integer>
+		inline constexpr size_t const integer_batch_size_v =
+		  sizeof( Integer ) == 4 ? 4 : 2;
+
+		template<typename CharT>
+		inline CharT *copy_digits( CharT *first, char const *digits,
+		                           size_t count ) noexcept {
+			for( size_t n = 0; n < count; ++n ) {
+				*first++ = static_cast<CharT>( digits[n] );
+			}
+			return first;
+		}
+
+		// Write integer_batch_size_v<Integer> values, each but the first preceded
+		// by separator unless separator_first is set
+		template<typename CharT, typename Integer>
+		CharT *format_integer_batch( CharT *first, Integer const *values,
+		                             daw::basic_string_view<CharT> separator,
+		                             bool separator_first ) noexcept {
+			using unsigned_t = unsigned_work_t<Integer>;
+			constexpr size_t const batch = integer_batch_size_v<Integer>;
+			constexpr uint32_t const group = 100'000'000U;
+
+			unsigned_t magnitudes[batch]{};
+			bool negative[batch]{};
+			uint32_t groups[4]{};
+			for( size_t n = 0; n < batch; ++n ) {
+				magnitudes[n] = static_cast<unsigned_t>( values[n] );
+				if constexpr( std::is_signed_v<Integer> ) {
+					if( values[n] < 0 ) {
+						negative[n] = true;
+						magnitudes[n] = static_cast<unsigned_t>( 0 ) - magnitudes[n];
+					}
+				}
+				if constexpr( sizeof( Integer ) == 4 ) {
+					groups[n] = static_cast<uint32_t>( magnitudes[n] % group );
+				} else {
+					groups[2 * n] =
+					  static_cast<uint32_t>( ( magnitudes[n] / group ) % group );
+					groups[2 * n + 1] = static_cast<uint32_t>( magnitudes[n] % group );
+				}
+			}
+			char digits[32];
+			simd::digits8x4( groups, digits );
+
+			// Each value owns 32 / batch digits, anything above that is written
+			// with the scalar kernel
+			constexpr size_t const width = 32U / batch;
+			constexpr uint64_t const width_limit = sizeof( Integer ) == 4
+			                                         ? 100'000'000ULL
+			                                         : 10'000'000'000'000'000ULL;
+			for( size_t n = 0; n < batch; ++n ) {
+				if( n > 0 || separator_first ) {
+					for( auto c : separator ) {
+						*first++ = c;
+					}
+				}
+				if( negative[n] ) {
+					*first++ = static_cast<CharT>( '-' );
+				}
+				size_t count = count_digits( magnitudes[n] );
+				if( count > width ) {
+					first = format_unsigned(
+					  first, static_cast<unsigned_t>( magnitudes[n] / width_limit ) );
+					count = width;
+				}
+				first = copy_digits( first, digits + n * width + ( width - count ),
+				                     count );
+			}
+			return first;
+		}
+	} // namespace impl
+} // namespace ostream_converters
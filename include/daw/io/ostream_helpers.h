@@ -69,6 +69,67 @@ namespace daw {
 	template<typename T>
 	constexpr bool is_asint_v = is_asint_t<T>::value;
 
+	template<size_t Precision, typename Float>
+	struct as_fixed_t {
+		Float value;
+	};
+
+	// Output value in fixed notation with Precision digits after the decimal
+	// point
+	template<size_t Precision, typename Float>
+	constexpr as_fixed_t<Precision, Float> as_fixed( Float value ) noexcept {
+		return {value};
+	}
+
+	template<typename>
+	struct is_asfixed_t : std::false_type {};
+
+	template<size_t Precision, typename Float>
+	struct is_asfixed_t<as_fixed_t<Precision, Float>> : std::true_type {};
+
+	template<typename T>
+	constexpr bool is_asfixed_v = is_asfixed_t<T>::value;
+
+	template<typename Float>
+	struct as_scientific_t {
+		Float value;
+	};
+
+	// Output value as d.ddde-x
+	template<typename Float>
+	constexpr as_scientific_t<Float> as_scientific( Float value ) noexcept {
+		return {value};
+	}
+
+	template<typename>
+	struct is_asscientific_t : std::false_type {};
+
+	template<typename Float>
+	struct is_asscientific_t<as_scientific_t<Float>> : std::true_type {};
+
+	template<typename T>
+	constexpr bool is_asscientific_v = is_asscientific_t<T>::value;
+
+	template<typename Float>
+	struct as_general_t {
+		Float value;
+	};
+
+	// Output value in fixed or scientific notation, whichever is shorter
+	template<typename Float>
+	constexpr as_general_t<Float> as_general( Float value ) noexcept {
+		return {value};
+	}
+
+	template<typename>
+	struct is_asgeneral_t : std::false_type {};
+
+	template<typename Float>
+	struct is_asgeneral_t<as_general_t<Float>> : std::true_type {};
+
+	template<typename T>
+	constexpr bool is_asgeneral_v = is_asgeneral_t<T>::value;
+
 	template<typename>
 	struct char_traits;
 
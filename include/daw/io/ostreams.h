@@ -22,11 +22,13 @@
 
 #pragma once
 
+#include <cstring>
 #include <type_traits>
 
 #include <daw/daw_traits.h>
 
 #include "ostream_converters.h"
+#include "ostream_converters_int_simd.h"
 
 namespace daw {
 	namespace io {
@@ -44,6 +46,10 @@ namespace daw {
 		 *     void operator( )( CharT c );
 		 *		// optional
 		 *		void operator( )( accept_asciiz, CharT const * ptr );
+		 *		// optional, count characters at once
+		 *		void operator( )( accept_sized, CharT const * ptr, size_t count );
+		 *		// optional, for streams that only need the length of values
+		 *		void operator( )( accept_length, size_t count );
 		 *
 		 *		      // String requires a size( ) and data( ) member
 		 *		      template<typename String,
@@ -52,6 +58,12 @@ namespace daw {
 		 *		                                  !::daw::traits::is_character_v<String>),
 		 *		                                std::nullptr_t> = nullptr>
 		 *		      void operator( )( String &&str );
+		 *
+		 *		// optional, converters write straight into the stream.  Return
+		 *		// a pointer to at least n writable characters or nullptr when
+		 *		// there is no room, then commit the k actually written
+		 *		CharT * prepare( size_t n );
+		 *		void commit( size_t k );
 		 *		    };
 		 *
 		 */
@@ -68,6 +80,21 @@ namespace daw {
 			  decltype( std::declval<remove_cvref_t<OutputStream>>( )(
 			    std::declval<accept_asciiz>( ), std::declval<CharT const *>( ) ) );
 
+			struct accept_sized {};
+
+			struct accept_length {};
+
+			template<typename OutputStream>
+			using has_operator_parens_length =
+			  decltype( std::declval<remove_cvref_t<OutputStream>>( )(
+			    std::declval<accept_length>( ), std::declval<size_t>( ) ) );
+
+			template<typename CharT, typename OutputStream>
+			using has_operator_parens_sized =
+			  decltype( std::declval<remove_cvref_t<OutputStream>>( )(
+			    std::declval<accept_sized>( ), std::declval<CharT const *>( ),
+			    std::declval<size_t>( ) ) );
+
 			template<typename CharT>
 			struct operator_parens_string_t {
 				CharT const *data( ) const;
@@ -80,6 +107,16 @@ namespace daw {
 			  decltype( std::declval<remove_cvref_t<OutputStream>>( )(
 			    std::declval<operator_parens_string_t<CharT>>( ) ) );
 
+			template<typename OutputStream>
+			using has_prepare =
+			  decltype( std::declval<remove_cvref_t<OutputStream> &>( ).prepare(
+			    std::declval<size_t>( ) ) );
+
+			template<typename OutputStream>
+			using has_commit =
+			  decltype( std::declval<remove_cvref_t<OutputStream> &>( ).commit(
+			    std::declval<size_t>( ) ) );
+
 			template<typename CharT, typename OutputStream>
 			constexpr bool has_operator_parans_char_v =
 			  daw::is_detected_v<has_operator_parens_char, CharT, OutputStream>;
@@ -91,6 +128,61 @@ namespace daw {
 			template<typename CharT, typename OutputStream>
 			constexpr bool has_operator_parans_string_v =
 			  daw::is_detected_v<has_operator_parens_string, CharT, OutputStream>;
+
+			template<typename CharT, typename OutputStream>
+			constexpr bool has_operator_parans_sized_v =
+			  daw::is_detected_v<has_operator_parens_sized, CharT, OutputStream>;
+
+			template<typename OutputStream>
+			constexpr bool has_operator_parans_length_v =
+			  daw::is_detected_v<has_operator_parens_length, OutputStream>;
+
+			// memcpy outside of constant expressions
+			template<typename CharT>
+			constexpr void copy_chars( CharT *dest, CharT const *src,
+			                           size_t count ) noexcept {
+				if( !::ostream_converters::impl::is_constant_evaluated( ) ) {
+					std::memcpy( dest, src, count * sizeof( CharT ) );
+					return;
+				}
+				for( size_t n = 0; n < count; ++n ) {
+					dest[n] = src[n];
+				}
+			}
+
+			// Write count characters with the stream's bulk write when it has one
+			template<typename CharT, typename OutputStream>
+			constexpr void write_chars( OutputStream &os, CharT const *ptr,
+			                            size_t count ) {
+				if constexpr( has_operator_parans_sized_v<CharT, OutputStream> ) {
+					os( accept_sized{}, ptr, count );
+				} else if constexpr( has_operator_parans_string_v<CharT,
+				                                                  OutputStream> ) {
+					os( daw::basic_string_view<CharT>( ptr, count ) );
+				} else {
+					for( size_t n = 0; n < count; ++n ) {
+						os( ptr[n] );
+					}
+				}
+			}
+
+			template<typename OutputStream>
+			constexpr bool has_prepare_commit_v =
+			  daw::all_true_v<daw::is_detected_v<has_prepare, OutputStream>,
+			                  daw::is_detected_v<has_commit, OutputStream>>;
+
+			template<typename OutputStream>
+			using has_mark =
+			  decltype( std::declval<remove_cvref_t<OutputStream> const &>( ).mark( ) );
+
+			template<typename OutputStream>
+			using has_rewind =
+			  decltype( std::declval<remove_cvref_t<OutputStream> &>( ).rewind(
+			    std::declval<has_mark<OutputStream>>( ) ) );
+
+			template<typename OutputStream>
+			constexpr bool has_mark_rewind_v =
+			  daw::is_detected_v<has_rewind, OutputStream>;
 		} // namespace impl
 
 		template<typename OutputStream>
@@ -103,7 +195,8 @@ namespace daw {
 		  std::enable_if_t<
 		    daw::all_true_v<
 		      is_output_stream_v<OutputStream>, daw::traits::is_character_v<CharT>,
-		      !impl::has_operator_parans_asciiz_v<CharT, OutputStream>>,
+		      ( !impl::has_operator_parans_asciiz_v<CharT, OutputStream> ||
+		        impl::has_operator_parans_sized_v<CharT, OutputStream> )>,
 		    std::nullptr_t> = nullptr>
 		constexpr OutputStream &
 		operator<<( OutputStream &os,
@@ -112,9 +205,7 @@ namespace daw {
 			static_assert( impl::has_operator_parans_char_v<CharT, OutputStream>,
 			               "Missing operator( )( CharT ) member on OutputStream" );
 
-			for( size_t n = 0; n < ( N - 1 ); ++n ) {
-				os( str[n] );
-			}
+			impl::write_chars( os, str, N - 1 );
 			return os;
 		}
 
@@ -123,7 +214,8 @@ namespace daw {
 		  std::enable_if_t<
 		    daw::all_true_v<
 		      is_output_stream_v<OutputStream>, daw::traits::is_character_v<CharT>,
-		      impl::has_operator_parans_asciiz_v<CharT, OutputStream>>,
+		      impl::has_operator_parans_asciiz_v<CharT, OutputStream>,
+		      !impl::has_operator_parans_sized_v<CharT, OutputStream>>,
 		    std::nullptr_t> = nullptr>
 		constexpr OutputStream &
 		operator<<( OutputStream &os,
@@ -136,7 +228,7 @@ namespace daw {
 			return os;
 		}
 
-		template<typename OutputStream, typename T, typename CharT, size_t N,
+		template<typename OutputStream, typename CharT, size_t N,
 		         std::enable_if_t<(is_output_stream_v<OutputStream>),
 		                          std::nullptr_t> = nullptr>
 		constexpr OutputStream &operator<<( OutputStream &os,
@@ -145,20 +237,7 @@ namespace daw {
 			  std::is_same_v<remove_cvref_t<typename OutputStream::character_t>,
 			                 remove_cvref_t<CharT>>,
 			  "Character type in OutputStream does not match that of stirng" );
-			os( impl::accept_asciiz{}, str.data( ) );
-			return os;
-		}
-
-		template<typename OutputStream, typename T, typename CharT, size_t N,
-		         std::enable_if_t<(is_output_stream_v<OutputStream>),
-		                          std::nullptr_t> = nullptr>
-		constexpr OutputStream &operator<<( OutputStream &os,
-		                                    static_string_t<CharT, N> &&str ) {
-			static_assert(
-			  std::is_same_v<remove_cvref_t<typename OutputStream::character_t>,
-			                 remove_cvref_t<CharT>>,
-			  "Character type in OutputStream does not match that of stirng" );
-			os( impl::accept_asciiz{}, str.data( ) );
+			impl::write_chars( os, str.data( ), str.size( ) );
 			return os;
 		}
 
@@ -175,8 +254,30 @@ namespace daw {
 			static_assert( impl::has_operator_parans_char_v<CharT, OutputStream>,
 			               "Missing operator( )( CharT ) member on OutputStream" );
 
-			using ::ostream_converters::to_os_string;
-			os( to_os_string<CharT>( std::forward<T>( value ) ) );
+			if constexpr( impl::has_operator_parans_length_v<OutputStream> ) {
+				// Measuring only, the value need not be formatted
+				os( impl::accept_length{},
+				    ::ostream_converters::formatted_size<CharT>( value ) );
+				return os;
+			} else {
+				if constexpr( all_true_v<
+				                ::ostream_converters::has_direct_converter_v<CharT, T>,
+				                impl::has_prepare_commit_v<OutputStream>> ) {
+					// Format in place when the stream has room for the longest value
+					using converter_t =
+					  ::ostream_converters::direct_converter<CharT, remove_cvref_t<T>>;
+					if( CharT *const first = os.prepare( converter_t::max_size );
+					    first != nullptr ) {
+						CharT *const last = converter_t::format( first, value );
+						os.commit( static_cast<size_t>( last - first ) );
+						return os;
+					}
+				}
+				using ::ostream_converters::to_os_string;
+				auto const str = to_os_string<CharT>( std::forward<T>( value ) );
+				impl::write_chars( os, str.data( ),
+				                   static_cast<size_t>( str.size( ) ) );
+			}
 			return os;
 		}
 
@@ -189,9 +290,273 @@ namespace daw {
 			// Is OutputStream callable with a single CharT
 			static_assert( impl::has_operator_parans_char_v<CharT, OutputStream>,
 			               "Missing operator( )( CharT ) member on OutputStream" );
+			static_assert(
+			  std::is_same_v<remove_cvref_t<CharT>,
+			                 remove_cvref_t<decltype( *value.data( ) )>>,
+			  "Character type in OutputStream does not match that of stirng" );
 
-			os( value );
+			impl::write_chars( os, value.data( ),
+			                   static_cast<size_t>( value.size( ) ) );
 			return os;
 		}
+
+		// Streams that only live for one statement, such as the lock holding
+		// stream from locked( )
+		template<typename OutputStream, typename T,
+		         std::enable_if_t<all_true_v<is_output_stream_v<OutputStream>,
+		                                     !std::is_lvalue_reference_v<OutputStream>>,
+		                          std::nullptr_t> = nullptr>
+		constexpr OutputStream &&operator<<( OutputStream &&os, T &&value ) {
+			static_cast<OutputStream &>( os ) << std::forward<T>( value );
+			return std::move( os );
+		}
+
+		namespace impl {
+			template<typename CharT, typename T>
+			constexpr bool is_batch_writable_v =
+			  ::ostream_converters::has_max_formatted_size_v<CharT, T> ||
+			  daw::impl::is_string_like_v<T>;
+
+			// The most characters value can be written as
+			template<typename CharT, typename T>
+			constexpr size_t write_bound( T const &value ) noexcept {
+				if constexpr( ::ostream_converters::has_max_formatted_size_v<CharT,
+				                                                             T> ) {
+					return ::ostream_converters::max_formatted_size_v<CharT, T>;
+				} else {
+					return static_cast<size_t>( value.size( ) );
+				}
+			}
+
+			// Write value to first, which has room for write_bound( value )
+			// characters
+			template<typename CharT, typename T>
+			constexpr CharT *write_one( CharT *first, T const &value ) {
+				using value_t = remove_cvref_t<T>;
+				if constexpr( ::ostream_converters::has_direct_converter_v<CharT,
+				                                                           value_t> ) {
+					return ::ostream_converters::direct_converter<CharT, value_t>::format(
+					  first, value );
+				} else if constexpr( ::ostream_converters::impl::is_char_array_v<
+				                       CharT, value_t> ) {
+					constexpr size_t const sz = std::extent_v<value_t> - 1U;
+					copy_chars( first, value, sz );
+					return first + sz;
+				} else if constexpr( daw::impl::is_string_like_v<value_t> ) {
+					static_assert(
+					  std::is_same_v<remove_cvref_t<CharT>,
+					                 remove_cvref_t<decltype( *value.data( ) )>>,
+					  "Character type in OutputStream does not match that of stirng" );
+					auto const sz = static_cast<size_t>( value.size( ) );
+					copy_chars( first, value.data( ), sz );
+					return first + sz;
+				} else {
+					using ::ostream_converters::to_os_string;
+					auto const str = to_os_string<CharT>( value );
+					auto const sz = static_cast<size_t>( str.size( ) );
+					copy_chars( first, str.data( ), sz );
+					return first + sz;
+				}
+			}
+		} // namespace impl
+
+		// Write all of args, as os << args0 << args1 << ... would.  When the
+		// stream supports prepare/commit and every argument has a maximum size
+		// or is a string, there is one capacity check for all of them and they
+		// are formatted straight into the stream
+		template<typename OutputStream, typename... Args,
+		         std::enable_if_t<is_output_stream_v<OutputStream>,
+		                          std::nullptr_t> = nullptr>
+		constexpr OutputStream &write( OutputStream &os, Args const &... args ) {
+			using CharT = typename remove_cvref_t<OutputStream>::character_t;
+			if constexpr( all_true_v<
+			                impl::has_prepare_commit_v<OutputStream>,
+			                !impl::has_operator_parans_length_v<OutputStream>,
+			                impl::is_batch_writable_v<CharT, Args>...> ) {
+				size_t const bound = ( impl::write_bound<CharT>( args ) + ... + 0U );
+				if( CharT *const first = os.prepare( bound ); first != nullptr ) {
+					CharT *last = first;
+					( ( last = impl::write_one( last, args ) ), ... );
+					os.commit( static_cast<size_t>( last - first ) );
+					return os;
+				}
+			}
+			return ( os << ... << args );
+		}
+
+		namespace impl {
+			template<typename T>
+			constexpr bool is_range_value_v =
+			  daw::all_true_v<std::is_arithmetic_v<T>, !std::is_same_v<bool, T>,
+			                  !daw::traits::is_character_v<T>>;
+
+			// The most characters any value of T can format to
+			template<typename T>
+			constexpr size_t range_value_size( ) noexcept {
+				return ::ostream_converters::max_formatted_size_v<char, T>;
+			}
+
+			template<typename CharT, typename T>
+			constexpr CharT *format_range_value( CharT *first, T value ) noexcept {
+				if constexpr( std::is_floating_point_v<T> ) {
+					return ::ostream_converters::impl::format_shortest<
+					  CharT, daw::char_traits<CharT>>( first, value );
+				} else {
+					return ::ostream_converters::impl::format_integer( first, value );
+				}
+			}
+		} // namespace impl
+
+		// Write a contiguous range of numbers with separator between them.  The
+		// numbers are formatted straight into a local buffer that is passed to
+		// the stream in large blocks, instead of one string per value.  32 and 64
+		// bit integers are formatted several at a time with SIMD when available
+		template<typename OutputStream, typename Container,
+		         std::enable_if_t<all_true_v<is_output_stream_v<OutputStream>,
+		                                     daw::impl::is_string_like_v<Container>>,
+		                          std::nullptr_t> = nullptr>
+		constexpr OutputStream &write_range(
+		  OutputStream &os, Container const &values,
+		  daw::basic_string_view<typename remove_cvref_t<OutputStream>::character_t>
+		    separator ) {
+			using CharT = typename remove_cvref_t<OutputStream>::character_t;
+			using value_t = remove_cvref_t<decltype( *values.data( ) )>;
+			static_assert( impl::is_range_value_v<value_t>,
+			               "write_range requires a range of integral or floating "
+			               "point numbers" );
+
+			constexpr size_t const buffer_size = 512;
+			constexpr size_t const value_size = impl::range_value_size<value_t>( );
+			static_assert( value_size <= buffer_size );
+
+			CharT buffer[buffer_size]{};
+			CharT *ptr = buffer;
+			auto const room = [&]( ) {
+				return static_cast<size_t>( ( buffer + buffer_size ) - ptr );
+			};
+			auto const flush = [&]( ) {
+				if( ptr != buffer ) {
+					impl::write_chars( os, buffer,
+					                   static_cast<size_t>( ptr - buffer ) );
+					ptr = buffer;
+				}
+			};
+
+			auto const *const first = values.data( );
+			auto const count = static_cast<size_t>( values.size( ) );
+			size_t n = 0;
+			if constexpr( ::ostream_converters::impl::has_integer_batch_v<
+			                value_t> ) {
+				// Several values at a time with the SIMD kernels when not in a
+				// constant expression
+				constexpr size_t const max_separator = 16;
+				constexpr size_t const batch =
+				  ::ostream_converters::impl::integer_batch_size_v<value_t>;
+				constexpr size_t const batch_size =
+				  batch * ( value_size + max_separator );
+				static_assert( batch_size <= buffer_size );
+				if( !::ostream_converters::impl::is_constant_evaluated( ) &&
+				    separator.size( ) <= max_separator ) {
+					for( ; n + batch <= count; n += batch ) {
+						if( room( ) < batch_size ) {
+							flush( );
+						}
+						ptr = ::ostream_converters::impl::format_integer_batch(
+						  ptr, first + n, separator, n > 0 );
+					}
+				}
+			}
+			for( ; n < count; ++n ) {
+				if( n > 0 && !separator.empty( ) ) {
+					if( separator.size( ) > room( ) ) {
+						flush( );
+					}
+					if( separator.size( ) > buffer_size ) {
+						impl::write_chars( os, separator.data( ), separator.size( ) );
+					} else {
+						for( auto c : separator ) {
+							*ptr++ = c;
+						}
+					}
+				}
+				if( room( ) < value_size ) {
+					flush( );
+				}
+				ptr = impl::format_range_value( ptr, first[n] );
+			}
+			flush( );
+			return os;
+		}
+
+		template<typename OutputStream, typename Container,
+		         std::enable_if_t<all_true_v<is_output_stream_v<OutputStream>,
+		                                     daw::impl::is_string_like_v<Container>>,
+		                          std::nullptr_t> = nullptr>
+		constexpr OutputStream &
+		write_range( OutputStream &os, Container const &values,
+		             typename remove_cvref_t<OutputStream>::character_t separator ) {
+			using CharT = typename remove_cvref_t<OutputStream>::character_t;
+			return write_range(
+			  os, values, daw::basic_string_view<CharT>( &separator, 1 ) );
+		}
+
+		// Speculative output.  What is written to the stream while the transaction
+		// is open is dropped when it ends without commit( ), or at any point with
+		// rewind( ).  Transactions nest, the stream must not be reset while one is
+		// open.
+		// Memory, chunked, counting and mmap file streams can always drop it.
+		// Streams that write a buffer to a file as it fills cannot take back what
+		// was written since the mark, rewind( ) then returns false and the stream
+		// is put in its failed state.  Keep transactions smaller than the buffer
+		// there
+		template<typename OutputStream>
+		class stream_transaction {
+			static_assert( impl::has_mark_rewind_v<OutputStream>,
+			               "OutputStream must have mark( ) and rewind( mark )" );
+			using mark_t = impl::has_mark<OutputStream>;
+
+			OutputStream *m_os;
+			mark_t m_mark;
+			bool m_is_open = true;
+
+		public:
+			explicit stream_transaction( OutputStream &os ) noexcept
+			  : m_os( &os )
+			  , m_mark( os.mark( ) ) {}
+
+			stream_transaction( stream_transaction const & ) = delete;
+			stream_transaction &operator=( stream_transaction const & ) = delete;
+
+			// A failed rewind is left to the stream's failed state
+			~stream_transaction( ) {
+				if( m_is_open ) {
+					(void)rewind( );
+				}
+			}
+
+			// Keep what was written
+			void commit( ) noexcept {
+				m_is_open = false;
+			}
+
+			// Drop what was written so far and keep the transaction open.  False
+			// when the stream could not drop all of it
+			bool rewind( ) noexcept {
+				if constexpr( std::is_void_v<decltype( m_os->rewind( m_mark ) )> ) {
+					m_os->rewind( m_mark );
+					return true;
+				} else {
+					return m_os->rewind( m_mark );
+				}
+			}
+		};
+
+		template<typename OutputStream,
+		         std::enable_if_t<is_output_stream_v<OutputStream>,
+		                          std::nullptr_t> = nullptr>
+		stream_transaction<OutputStream>
+		make_stream_transaction( OutputStream &os ) noexcept {
+			return stream_transaction<OutputStream>( os );
+		}
 	} // namespace io
 } // namespace daw
@@ -0,0 +1,901 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2019 Darrell Wright
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files( the "Software" ), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and / or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <daw/daw_string_view.h>
+#include <daw/daw_traits.h>
+
+#include "ostream_converters.h"
+#include "ostreams.h"
+
+namespace daw {
+	namespace io {
+		namespace impl {
+			struct printf_spec {
+				bool left = false;
+				bool plus = false;
+				bool space = false;
+				bool alt = false;
+				bool zero = false;
+				bool width_arg = false;
+				bool precision_arg = false;
+				// 'H' for hh, 'h', 'l' for l and ll or 0
+				char length = 0;
+				char conversion = 0;
+				int width = 0;
+				// Negative when not given
+				int precision = -1;
+			};
+
+			// Literal text of the format string followed by a conversion when
+			// has_spec is set
+			struct printf_item {
+				size_t literal_first = 0;
+				size_t literal_size = 0;
+				bool has_spec = false;
+				printf_spec spec{};
+			};
+
+			template<typename CharT>
+			constexpr bool is_printf_digit( CharT c ) noexcept {
+				return static_cast<CharT>( '0' ) <= c && c <= static_cast<CharT>( '9' );
+			}
+
+			template<typename CharT>
+			int parse_printf_int( CharT const *fmt, size_t &pos ) noexcept {
+				int result = 0;
+				while( is_printf_digit( fmt[pos] ) ) {
+					result = result * 10 + static_cast<int>( fmt[pos] - '0' );
+					++pos;
+				}
+				return result;
+			}
+
+			// Parse a %... conversion after the %.  Returns false when it is not
+			// one we know, it is then written as is
+			template<typename CharT>
+			bool parse_printf_spec( CharT const *fmt, size_t &pos,
+			                        printf_spec &spec ) noexcept {
+				for( bool is_flag = true; is_flag; ) {
+					switch( static_cast<char>( fmt[pos] ) ) {
+					case '-':
+						spec.left = true;
+						break;
+					case '+':
+						spec.plus = true;
+						break;
+					case ' ':
+						spec.space = true;
+						break;
+					case '#':
+						spec.alt = true;
+						break;
+					case '0':
+						spec.zero = true;
+						break;
+					default:
+						is_flag = false;
+						continue;
+					}
+					++pos;
+				}
+				if( fmt[pos] == static_cast<CharT>( '*' ) ) {
+					spec.width_arg = true;
+					++pos;
+				} else {
+					spec.width = parse_printf_int( fmt, pos );
+				}
+				if( fmt[pos] == static_cast<CharT>( '.' ) ) {
+					++pos;
+					if( fmt[pos] == static_cast<CharT>( '*' ) ) {
+						spec.precision_arg = true;
+						++pos;
+					} else {
+						spec.precision = parse_printf_int( fmt, pos );
+					}
+				}
+				switch( static_cast<char>( fmt[pos] ) ) {
+				case 'h':
+					++pos;
+					spec.length = 'h';
+					if( fmt[pos] == static_cast<CharT>( 'h' ) ) {
+						++pos;
+						spec.length = 'H';
+					}
+					break;
+				case 'l':
+					++pos;
+					spec.length = 'l';
+					if( fmt[pos] == static_cast<CharT>( 'l' ) ) {
+						++pos;
+					}
+					break;
+				case 'L':
+				case 'j':
+				case 'z':
+				case 't':
+					++pos;
+					spec.length = 'l';
+					break;
+				default:
+					break;
+				}
+				switch( static_cast<char>( fmt[pos] ) ) {
+				case 'd':
+				case 'i':
+				case 'u':
+				case 'o':
+				case 'x':
+				case 'X':
+				case 'c':
+				case 's':
+				case 'p':
+				case 'f':
+				case 'F':
+				case 'e':
+				case 'E':
+				case 'g':
+				case 'G':
+				case 'a':
+				case 'A':
+					spec.conversion = static_cast<char>( fmt[pos] );
+					++pos;
+					return true;
+				default:
+					return false;
+				}
+			}
+
+			template<typename CharT>
+			std::vector<printf_item> parse_printf( CharT const *fmt ) {
+				std::vector<printf_item> result{};
+				printf_item item{};
+				size_t pos = 0;
+				while( fmt[pos] != CharT{} ) {
+					if( fmt[pos] != static_cast<CharT>( '%' ) ) {
+						++pos;
+						++item.literal_size;
+						continue;
+					}
+					if( fmt[pos + 1] == static_cast<CharT>( '%' ) ) {
+						// The literal continues from the second %
+						result.push_back( item );
+						item = printf_item{};
+						item.literal_first = pos + 1;
+						item.literal_size = 1;
+						pos += 2;
+						continue;
+					}
+					size_t spec_pos = pos + 1;
+					if( !parse_printf_spec( fmt, spec_pos, item.spec ) ) {
+						item.spec = printf_spec{};
+						++pos;
+						++item.literal_size;
+						continue;
+					}
+					item.has_spec = true;
+					result.push_back( item );
+					item = printf_item{};
+					item.literal_first = spec_pos;
+					pos = spec_pos;
+				}
+				if( item.literal_size > 0 ) {
+					result.push_back( item );
+				}
+				return result;
+			}
+
+			template<typename CharT>
+			struct printf_cache_entry {
+				CharT const *format = nullptr;
+				std::vector<printf_item> items{};
+			};
+
+			// The parsed form of fmt, cached per thread by the address of the
+			// format string alone.  The text is not looked at again, a format that
+			// can change must go through printf_uncached
+			template<typename CharT>
+			std::vector<printf_item> const &parsed_printf( CharT const *fmt ) {
+				constexpr size_t const cache_size = 64;
+				thread_local std::array<printf_cache_entry<CharT>, cache_size>
+				  cache{};
+				auto const address = reinterpret_cast<uintptr_t>( fmt );
+				auto &entry = cache[( address ^ ( address >> 7U ) ) % cache_size];
+				if( entry.format != fmt ) {
+					entry.items = parse_printf( fmt );
+					entry.format = fmt;
+				}
+				return entry.items;
+			}
+
+			enum class printf_arg_type {
+				signed_int,
+				unsigned_int,
+				floating,
+				character,
+				string,
+				pointer
+			};
+
+			template<typename CharT>
+			struct printf_arg {
+				printf_arg_type type = printf_arg_type::signed_int;
+				// Bytes in the integer type, for %u and %x of negative values
+				size_t int_size = sizeof( int );
+				int64_t i = 0;
+				uint64_t u = 0;
+				double d = 0.0;
+				CharT const *str = nullptr;
+				size_t str_size = 0;
+				void const *ptr = nullptr;
+			};
+
+			template<typename CharT, typename T>
+			printf_arg<CharT> make_printf_arg( T const &value ) noexcept {
+				printf_arg<CharT> result{};
+				if constexpr( std::is_same_v<T, bool> ) {
+					result.i = value ? 1 : 0;
+				} else if constexpr( daw::traits::is_character_v<T> ) {
+					result.type = printf_arg_type::character;
+					result.i = static_cast<int64_t>( value );
+				} else if constexpr( std::is_integral_v<T> ) {
+					result.int_size = sizeof( T );
+					if constexpr( std::is_signed_v<T> ) {
+						result.i = static_cast<int64_t>( value );
+					} else {
+						result.type = printf_arg_type::unsigned_int;
+						result.u = static_cast<uint64_t>( value );
+					}
+				} else if constexpr( std::is_floating_point_v<T> ) {
+					result.type = printf_arg_type::floating;
+					result.d = static_cast<double>( value );
+				} else if constexpr( std::is_same_v<std::decay_t<T>, CharT const *> ||
+				                     std::is_same_v<std::decay_t<T>, CharT *> ) {
+					result.type = printf_arg_type::string;
+					result.str = value;
+					result.str_size = static_cast<size_t>( -1 );
+				} else if constexpr( daw::impl::is_string_like_v<T> ) {
+					static_assert(
+					  std::is_same_v<CharT, remove_cvref_t<decltype( *value.data( ) )>>,
+					  "Character type in OutputStream does not match that of stirng" );
+					result.type = printf_arg_type::string;
+					result.str = value.data( );
+					result.str_size = static_cast<size_t>( value.size( ) );
+				} else if constexpr( std::is_pointer_v<T> ||
+				                     std::is_null_pointer_v<T> ) {
+					result.type = printf_arg_type::pointer;
+					result.ptr = static_cast<void const *>( value );
+				} else {
+					static_assert( std::is_arithmetic_v<T>,
+					               "printf arguments must be numbers, characters, "
+					               "strings or pointers" );
+				}
+				return result;
+			}
+
+			// A conversion's output in parts: sign and radix prefix, leading zeros
+			// from the precision and the digits or text
+			struct printf_field {
+				char prefix[3]{};
+				size_t prefix_size = 0;
+				size_t zeros = 0;
+				bool zero_pad = false;
+
+				void add_prefix( char c ) noexcept {
+					prefix[prefix_size++] = c;
+				}
+			};
+
+			template<typename CharT, typename OutputStream>
+			void printf_fill( OutputStream &os, char c, size_t count ) {
+				CharT block[32];
+				for( auto &b : block ) {
+					b = static_cast<CharT>( c );
+				}
+				while( count > 0 ) {
+					auto const sz = count < 32U ? count : size_t{32};
+					write_chars( os, block, sz );
+					count -= sz;
+				}
+			}
+
+			template<typename CharT, typename OutputStream, typename BodyChar>
+			void printf_write( OutputStream &os, BodyChar const *ptr,
+			                   size_t count ) {
+				if constexpr( std::is_same_v<CharT, BodyChar> ) {
+					write_chars( os, ptr, count );
+				} else {
+					CharT block[64];
+					while( count > 0 ) {
+						auto const sz = count < 64U ? count : size_t{64};
+						for( size_t n = 0; n < sz; ++n ) {
+							block[n] = static_cast<CharT>( ptr[n] );
+						}
+						write_chars( os, block, sz );
+						ptr += sz;
+						count -= sz;
+					}
+				}
+			}
+
+			// Pad to the field width and write
+			template<typename CharT, typename OutputStream, typename BodyChar>
+			void printf_emit( OutputStream &os, printf_spec const &spec,
+			                  printf_field const &field, BodyChar const *body,
+			                  size_t body_size ) {
+				auto const size = field.prefix_size + field.zeros + body_size;
+				auto const width = static_cast<size_t>( spec.width );
+				size_t pad = width > size ? width - size : 0U;
+				if( pad > 0 && !spec.left && !field.zero_pad ) {
+					printf_fill<CharT>( os, ' ', pad );
+					pad = 0;
+				}
+				printf_write<CharT>( os, field.prefix, field.prefix_size );
+				if( !spec.left ) {
+					printf_fill<CharT>( os, '0', field.zeros + pad );
+					pad = 0;
+				} else {
+					printf_fill<CharT>( os, '0', field.zeros );
+				}
+				printf_write<CharT>( os, body, body_size );
+				printf_fill<CharT>( os, ' ', pad );
+			}
+
+			// Digits of value in base 8 or 16, right aligned to last
+			inline char *printf_digits( char *last, uint64_t value, unsigned base,
+			                            bool upper ) noexcept {
+				char const *const digits =
+				  upper ? "0123456789ABCDEF" : "0123456789abcdef";
+				do {
+					*--last = digits[value % base];
+					value /= base;
+				} while( value > 0 );
+				return last;
+			}
+
+			template<typename CharT, typename OutputStream>
+			void printf_integer( OutputStream &os, printf_spec const &spec,
+			                     printf_arg<CharT> const &arg ) {
+				char const conv = spec.conversion;
+				bool const is_signed_conv = conv == 'd' || conv == 'i';
+				bool negative = false;
+				uint64_t value = 0;
+				bool const is_signed_arg = arg.type != printf_arg_type::unsigned_int;
+				if( is_signed_conv ) {
+					int64_t v = is_signed_arg ? arg.i : 0;
+					if( is_signed_arg ) {
+						if( spec.length == 'H' ) {
+							v = static_cast<int8_t>( v );
+						} else if( spec.length == 'h' ) {
+							v = static_cast<int16_t>( v );
+						}
+						negative = v < 0;
+						value = negative ? 0U - static_cast<uint64_t>( v )
+						                 : static_cast<uint64_t>( v );
+					} else {
+						value = arg.u;
+					}
+				} else {
+					value = is_signed_arg ? static_cast<uint64_t>( arg.i ) : arg.u;
+					auto bytes = arg.int_size;
+					if( spec.length == 'H' ) {
+						bytes = 1;
+					} else if( spec.length == 'h' ) {
+						bytes = 2;
+					}
+					if( bytes < 8 ) {
+						value &= ( 1ULL << ( bytes * 8U ) ) - 1U;
+					}
+				}
+				printf_field field{};
+				if( negative ) {
+					field.add_prefix( '-' );
+				} else if( is_signed_conv && spec.plus ) {
+					field.add_prefix( '+' );
+				} else if( is_signed_conv && spec.space ) {
+					field.add_prefix( ' ' );
+				}
+				unsigned const base =
+				  conv == 'o' ? 8U : ( conv == 'x' || conv == 'X' ) ? 16U : 10U;
+				char buffer[24];
+				char *first = buffer;
+				char *last = buffer;
+				if( !( value == 0 && spec.precision == 0 ) ) {
+					if( base == 10U ) {
+						last =
+						  ::ostream_converters::impl::format_unsigned( buffer, value );
+					} else {
+						last = buffer + 24;
+						first = printf_digits( last, value, base, conv == 'X' );
+					}
+				}
+				auto const digits = static_cast<size_t>( last - first );
+				if( spec.precision > 0 &&
+				    static_cast<size_t>( spec.precision ) > digits ) {
+					field.zeros = static_cast<size_t>( spec.precision ) - digits;
+				}
+				if( spec.alt ) {
+					if( base == 8U && field.zeros == 0 &&
+					    ( digits == 0 || *first != '0' ) ) {
+						field.zeros = 1;
+					} else if( base == 16U && value != 0 ) {
+						field.add_prefix( '0' );
+						field.add_prefix( conv );
+					}
+				}
+				field.zero_pad = spec.zero && !spec.left && spec.precision < 0;
+				printf_emit<CharT>( os, spec, field, first, digits );
+			}
+
+			// Room for up to count chars, on the stack when it fits
+			struct printf_buffer {
+				char stack[512];
+				std::unique_ptr<char[]> heap{};
+
+				char *get( size_t count ) {
+					if( count <= sizeof( stack ) ) {
+						return stack;
+					}
+					heap.reset( new char[count] );
+					return heap.get( );
+				}
+			};
+
+			// The digits of value rounded to digits significant digits, as
+			// d[0] . d[1] ... times 10^exponent.  value is finite and positive
+			inline int printf_significant( double value, size_t digits,
+			                               printf_buffer &buffer, char *&out ) {
+				using ::ostream_converters::impl::format_fixed;
+				using traits_t = daw::char_traits<char>;
+				// An estimate, it can be one off either way near a power of ten
+				auto exponent = static_cast<int>( std::floor( std::log10( value ) ) );
+				bool raised = false;
+				for( ;; ) {
+					auto const frac = static_cast<int>( digits ) - 1 - exponent;
+					if( frac >= 0 ) {
+						char *const first = buffer.get(
+						  ::ostream_converters::impl::fixed_buff_size<double> +
+						  static_cast<size_t>( frac ) + 2U );
+						char *const last = format_fixed<char, traits_t>(
+						  first, value, static_cast<uint32_t>( frac ) );
+						// Keep the significant digits only
+						char *ptr = first;
+						size_t count = 0;
+						for( char *p = first; p != last; ++p ) {
+							if( *p == '.' || ( count == 0 && *p == '0' ) ) {
+								continue;
+							}
+							*ptr++ = *p;
+							++count;
+						}
+						bool power_of_ten = count > 0 && first[0] == '1';
+						for( size_t n = 1; power_of_ten && n < count; ++n ) {
+							power_of_ten = first[n] == '0';
+						}
+						if( count == digits + 1 ) {
+							++exponent;
+							if( !power_of_ten ) {
+								// The estimate was one too low
+								raised = true;
+								continue;
+							}
+							// Rounded up to the next power of ten
+							--count;
+						} else if( count + 1 == digits ) {
+							// The estimate was one too high
+							--exponent;
+							continue;
+						} else if( power_of_ten && !raised ) {
+							// Either value is at least 10^exponent or it is below and
+							// the estimate was one too high, rounding up into the next
+							// decade.  One digit more tells them apart
+							--exponent;
+							raised = true;
+							continue;
+						}
+						out = first;
+						return exponent;
+					}
+					// Exact digits of the whole value, rounded here half to even
+					uint32_t const fraction = value < 9007199254740992.0 ? 52U : 0U;
+					char *const first = buffer.get(
+					  ::ostream_converters::impl::fixed_buff_size<double> + fraction +
+					  2U );
+					char *const last =
+					  format_fixed<char, traits_t>( first, value, fraction );
+					char *ptr = first;
+					size_t whole = 0;
+					bool in_whole = true;
+					for( char *p = first; p != last; ++p ) {
+						if( *p == '.' ) {
+							in_whole = false;
+							continue;
+						}
+						whole += in_whole ? 1U : 0U;
+						*ptr++ = *p;
+					}
+					exponent = static_cast<int>( whole ) - 1;
+					auto const total = static_cast<size_t>( ptr - first );
+					bool round_up = false;
+					if( first[digits] > '5' ) {
+						round_up = true;
+					} else if( first[digits] == '5' ) {
+						for( size_t n = digits + 1; n < total; ++n ) {
+							if( first[n] != '0' ) {
+								round_up = true;
+								break;
+							}
+						}
+						if( !round_up ) {
+							round_up = ( first[digits - 1] - '0' ) % 2 == 1;
+						}
+					}
+					if( round_up ) {
+						size_t n = digits;
+						while( n > 0 && first[n - 1] == '9' ) {
+							first[--n] = '0';
+						}
+						if( n == 0 ) {
+							first[0] = '1';
+							++exponent;
+						} else {
+							++first[n - 1];
+						}
+					}
+					out = first;
+					return exponent;
+				}
+			}
+
+			// d.ddde+xx from digits + 1 significant digits
+			inline char *printf_exponent_form( char *first, char const *digits,
+			                                   size_t precision, int exponent,
+			                                   bool alt, bool upper ) noexcept {
+				*first++ = digits[0];
+				if( precision > 0 || alt ) {
+					*first++ = '.';
+				}
+				for( size_t n = 1; n <= precision; ++n ) {
+					*first++ = digits[n];
+				}
+				*first++ = upper ? 'E' : 'e';
+				*first++ = exponent < 0 ? '-' : '+';
+				auto const abs_exponent =
+				  static_cast<uint32_t>( exponent < 0 ? -exponent : exponent );
+				if( abs_exponent < 10 ) {
+					*first++ = '0';
+				}
+				return ::ostream_converters::impl::format_unsigned( first,
+				                                                     abs_exponent );
+			}
+
+			inline char *printf_hex_float( char *first, double value, int precision,
+			                               bool alt, bool upper ) noexcept {
+				uint64_t bits = 0;
+				std::memcpy( &bits, &value, sizeof( bits ) );
+				uint64_t mantissa = bits & ( ( 1ULL << 52U ) - 1U );
+				auto const biased_exponent = static_cast<int>( ( bits >> 52U ) & 0x7FFU );
+				int exponent = 0;
+				char lead = '0';
+				if( biased_exponent != 0 ) {
+					lead = '1';
+					exponent = biased_exponent - 1023;
+				} else if( mantissa != 0 ) {
+					exponent = -1022;
+				}
+				size_t hex_digits = 13;
+				if( precision >= 0 && precision < 13 ) {
+					// Round the 52 bit fraction to precision hex digits, half to even
+					// The leading digit takes part so that it can round too
+					auto const drop = static_cast<uint32_t>( 13 - precision ) * 4U;
+					mantissa |= static_cast<uint64_t>( lead - '0' ) << 52U;
+					auto const rem = mantissa & ( ( 1ULL << drop ) - 1U );
+					auto const half = 1ULL << ( drop - 1U );
+					mantissa >>= drop;
+					if( rem > half || ( rem == half && ( mantissa & 1U ) == 1U ) ) {
+						++mantissa;
+					}
+					hex_digits = static_cast<size_t>( precision );
+					lead = static_cast<char>( '0' + ( mantissa >> ( hex_digits * 4U ) ) );
+					mantissa &= ( 1ULL << ( hex_digits * 4U ) ) - 1U;
+				} else if( precision < 0 ) {
+					while( hex_digits > 0 && ( mantissa & 0xFU ) == 0 ) {
+						mantissa >>= 4U;
+						--hex_digits;
+					}
+				}
+				char const *const digits =
+				  upper ? "0123456789ABCDEF" : "0123456789abcdef";
+				*first++ = lead;
+				auto const extra = precision > 13 ? static_cast<size_t>( precision - 13 )
+				                                  : size_t{0};
+				if( hex_digits > 0 || extra > 0 || alt ) {
+					*first++ = '.';
+				}
+				for( size_t n = hex_digits; n > 0; --n ) {
+					*first++ = digits[( mantissa >> ( ( n - 1U ) * 4U ) ) & 0xFU];
+				}
+				for( size_t n = 0; n < extra; ++n ) {
+					*first++ = '0';
+				}
+				*first++ = upper ? 'P' : 'p';
+				*first++ = exponent < 0 ? '-' : '+';
+				return ::ostream_converters::impl::format_unsigned(
+				  first, static_cast<uint32_t>( exponent < 0 ? -exponent : exponent ) );
+			}
+
+			template<typename CharT, typename OutputStream>
+			void printf_float( OutputStream &os, printf_spec const &spec,
+			                   printf_arg<CharT> const &arg ) {
+				char const conv = spec.conversion;
+				bool const upper = conv == 'F' || conv == 'E' || conv == 'G' ||
+				                   conv == 'A';
+				double value = arg.type == printf_arg_type::floating
+				                 ? arg.d
+				                 : arg.type == printf_arg_type::unsigned_int
+				                     ? static_cast<double>( arg.u )
+				                     : static_cast<double>( arg.i );
+				printf_field field{};
+				if( std::signbit( value ) ) {
+					field.add_prefix( '-' );
+					value = -value;
+				} else if( spec.plus ) {
+					field.add_prefix( '+' );
+				} else if( spec.space ) {
+					field.add_prefix( ' ' );
+				}
+				if( !std::isfinite( value ) ) {
+					char const *text = std::isnan( value ) ? ( upper ? "NAN" : "nan" )
+					                                       : ( upper ? "INF" : "inf" );
+					printf_emit<CharT>( os, spec, field, text, 3 );
+					return;
+				}
+				field.zero_pad = spec.zero && !spec.left;
+				printf_buffer buffer{};
+				char *first = nullptr;
+				char *last = nullptr;
+				if( conv == 'a' || conv == 'A' ) {
+					field.add_prefix( '0' );
+					field.add_prefix( upper ? 'X' : 'x' );
+					first = buffer.get( 32U + static_cast<size_t>(
+					                            spec.precision > 0 ? spec.precision : 0 ) );
+					last =
+					  printf_hex_float( first, value, spec.precision, spec.alt, upper );
+					printf_emit<CharT>( os, spec, field, first,
+					                    static_cast<size_t>( last - first ) );
+					return;
+				}
+				auto precision =
+				  static_cast<size_t>( spec.precision < 0 ? 6 : spec.precision );
+				bool use_fixed = conv == 'f' || conv == 'F';
+				bool trim = false;
+				int exponent = 0;
+				char *digits = nullptr;
+				printf_buffer digit_buffer{};
+				if( conv == 'g' || conv == 'G' ) {
+					if( precision == 0 ) {
+						precision = 1;
+					}
+					if( value != 0.0 ) {
+						exponent =
+						  printf_significant( value, precision, digit_buffer, digits );
+					}
+					if( static_cast<int>( precision ) > exponent && exponent >= -4 ) {
+						use_fixed = true;
+						precision = static_cast<size_t>(
+						  static_cast<int>( precision ) - 1 - exponent );
+					} else {
+						precision -= 1U;
+					}
+					trim = !spec.alt;
+				} else if( !use_fixed && value != 0.0 ) {
+					exponent =
+					  printf_significant( value, precision + 1U, digit_buffer, digits );
+				}
+				if( use_fixed ) {
+					first = buffer.get(
+					  ::ostream_converters::impl::fixed_buff_size<double> + precision +
+					  2U );
+					last = ::ostream_converters::impl::format_fixed<
+					  char, daw::char_traits<char>>( first, value,
+					                                 static_cast<uint32_t>( precision ) );
+				} else {
+					if( value == 0.0 ) {
+						char *const zeros = digit_buffer.get( precision + 1U );
+						std::memset( zeros, '0', precision + 1U );
+						digits = zeros;
+					}
+					first = buffer.get( precision + 16U );
+					last = printf_exponent_form( first, digits, precision, exponent,
+					                             spec.alt, upper );
+				}
+				if( trim ) {
+					// %g drops trailing zeros of the fraction
+					char *const exp_first = use_fixed ? last : last - 4 -
+					                                   ( exponent >= 100 || exponent <= -100 );
+					char *end = exp_first;
+					if( std::memchr( first, '.', static_cast<size_t>( end - first ) ) ) {
+						while( *( end - 1 ) == '0' ) {
+							--end;
+						}
+						if( *( end - 1 ) == '.' ) {
+							--end;
+						}
+						if( end != exp_first ) {
+							last = std::copy( exp_first, last, end );
+						}
+					}
+				} else if( use_fixed && precision == 0 && spec.alt ) {
+					*last++ = '.';
+				}
+				printf_emit<CharT>( os, spec, field, first,
+				                    static_cast<size_t>( last - first ) );
+			}
+
+			template<typename CharT, typename OutputStream>
+			void printf_one( OutputStream &os, printf_spec const &spec,
+			                 printf_arg<CharT> const &arg ) {
+				switch( spec.conversion ) {
+				case 'c': {
+					CharT const c = static_cast<CharT>( arg.i );
+					printf_emit<CharT>( os, spec, printf_field{}, &c, 1 );
+					return;
+				}
+				case 's': {
+					if( arg.type != printf_arg_type::string ) {
+						return;
+					}
+					if( arg.str == nullptr ) {
+						printf_emit<CharT>( os, spec, printf_field{}, "(null)", 6 );
+						return;
+					}
+					size_t size = arg.str_size;
+					auto const limit = spec.precision < 0
+					                     ? static_cast<size_t>( -1 )
+					                     : static_cast<size_t>( spec.precision );
+					if( size == static_cast<size_t>( -1 ) ) {
+						size = 0;
+						while( size < limit && arg.str[size] != CharT{} ) {
+							++size;
+						}
+					} else if( size > limit ) {
+						size = limit;
+					}
+					printf_emit<CharT>( os, spec, printf_field{}, arg.str, size );
+					return;
+				}
+				case 'p': {
+					if( arg.ptr == nullptr ) {
+						printf_emit<CharT>( os, spec, printf_field{}, "(nil)", 5 );
+						return;
+					}
+					printf_spec hex = spec;
+					hex.conversion = 'x';
+					hex.alt = true;
+					printf_arg<CharT> value{};
+					value.type = printf_arg_type::unsigned_int;
+					value.int_size = sizeof( void * );
+					value.u = static_cast<uint64_t>(
+					  reinterpret_cast<uintptr_t>( arg.ptr ) );
+					printf_integer<CharT>( os, hex, value );
+					return;
+				}
+				case 'f':
+				case 'F':
+				case 'e':
+				case 'E':
+				case 'g':
+				case 'G':
+				case 'a':
+				case 'A':
+					printf_float<CharT>( os, spec, arg );
+					return;
+				default:
+					printf_integer<CharT>( os, spec, arg );
+					return;
+				}
+			}
+
+			template<typename CharT, typename OutputStream, typename... Args>
+			void printf_items( OutputStream &os, CharT const *fmt,
+			                   std::vector<printf_item> const &items,
+			                   Args const &... args ) {
+				printf_arg<CharT> const arg_list[sizeof...( Args ) + 1] = {
+				  make_printf_arg<CharT>( args )..., printf_arg<CharT>{}};
+				size_t arg_pos = 0;
+				auto const next_arg = [&]( ) -> printf_arg<CharT> const & {
+					if( arg_pos < sizeof...( Args ) ) {
+						return arg_list[arg_pos++];
+					}
+					return arg_list[sizeof...( Args )];
+				};
+				auto const int_arg = [&]( ) {
+					auto const &arg = next_arg( );
+					return static_cast<int>(
+					  arg.type == printf_arg_type::unsigned_int
+					    ? static_cast<int64_t>( arg.u )
+					    : arg.i );
+				};
+				for( auto const &item : items ) {
+					if( item.literal_size > 0 ) {
+						write_chars( os, fmt + item.literal_first, item.literal_size );
+					}
+					if( !item.has_spec ) {
+						continue;
+					}
+					auto spec = item.spec;
+					if( spec.width_arg ) {
+						spec.width = int_arg( );
+						if( spec.width < 0 ) {
+							spec.left = true;
+							spec.width = -spec.width;
+						}
+					}
+					if( spec.precision_arg ) {
+						spec.precision = int_arg( );
+					}
+					printf_one<CharT>( os, spec, next_arg( ) );
+				}
+			}
+		} // namespace impl
+
+		// printf style formatting to an OutputStream, with the flags, width,
+		// precision and conversions of std::printf.  The arguments are type
+		// checked and formatted with the library's converters.  Format strings
+		// are parsed once per thread and cached by address alone, so they must be
+		// string literals or otherwise never change.  Use printf_uncached for
+		// formats built at runtime
+		template<typename OutputStream, typename... Args,
+		         std::enable_if_t<is_output_stream_v<OutputStream>,
+		                          std::nullptr_t> = nullptr>
+		OutputStream &
+		printf( OutputStream &os,
+		        typename remove_cvref_t<OutputStream>::character_t const *fmt,
+		        Args const &... args ) {
+			impl::printf_items( os, fmt, impl::parsed_printf( fmt ), args... );
+			return os;
+		}
+
+		// printf that parses fmt on every call, for formats that can change
+		template<typename OutputStream, typename... Args,
+		         std::enable_if_t<is_output_stream_v<OutputStream>,
+		                          std::nullptr_t> = nullptr>
+		OutputStream &printf_uncached(
+		  OutputStream &os,
+		  typename remove_cvref_t<OutputStream>::character_t const *fmt,
+		  Args const &... args ) {
+			impl::printf_items( os, fmt, impl::parse_printf( fmt ), args... );
+			return os;
+		}
+	} // namespace io
+} // namespace daw
@@ -0,0 +1,105 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2019 Darrell Wright
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files( the "Software" ), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and / or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <cstdio>
+#include <string>
+
+#include "daw/io/ostreams.h"
+
+// Checks shared by the tests of the streams that write to files
+namespace file_stream_test {
+	inline bool check( bool b, char const *what ) {
+		if( !b ) {
+			printf( "Failed: %s\n", what );
+		}
+		return b;
+	}
+
+	inline std::string read_file( char const *file_name ) {
+		std::string result{};
+		FILE *f = fopen( file_name, "rb" );
+		if( f == nullptr ) {
+			return result;
+		}
+		char buff[4096];
+		size_t count = 0;
+		while( ( count = fread( buff, 1, sizeof( buff ), f ) ) > 0 ) {
+			result.append( buff, count );
+		}
+		fclose( f );
+		return result;
+	}
+
+	// Lines of numbers in [first, last), added to expected as they should read
+	template<typename OutputStream>
+	void write_lines( OutputStream &fs_out, std::string &expected, int first,
+	                  int last ) {
+		for( int n = first; n < last; ++n ) {
+			fs_out << "The number is: " << n << ' ' << 1.5 * n << '\n';
+			expected += "The number is: " + std::to_string( n ) + ' ' +
+			            ( n % 2 == 0 ? std::to_string( 3 * n / 2 )
+			                         : std::to_string( 3 * n / 2 ) + ".5" ) +
+			            '\n';
+		}
+	}
+
+	// Output after a mark is dropped by rewinding to it
+	template<typename OutputStream>
+	bool check_rewind( OutputStream &fs_out, std::string const &expected ) {
+		auto const m = fs_out.mark( );
+		fs_out << "dropped";
+		fs_out.rewind( m );
+		return check( fs_out.size( ) == expected.size( ), "rewind" );
+	}
+
+	// A transaction that outgrows the buffer of a stream that writes it to the
+	// file as it fills cannot be rolled back, that must be reported.  open( )
+	// returns a new stream with a buffer of buffer_size characters
+	template<typename Open>
+	bool check_rewind_past_buffer( size_t buffer_size, Open open ) {
+		auto fs_out = open( );
+		auto tx = daw::io::make_stream_transaction( fs_out );
+		fs_out << "partial";
+		for( size_t n = 0; n <= buffer_size; ++n ) {
+			fs_out << 'x';
+		}
+		bool const rewound = tx.rewind( );
+		tx.commit( );
+		return check( !rewound && !fs_out, "rewind past the buffer" );
+	}
+
+	// Reopen file_name for appending with open( ) and add a line
+	template<typename Open>
+	bool check_append( char const *file_name, std::string &expected,
+	                   Open open ) {
+		bool good = true;
+		{
+			auto fs_out = open( );
+			fs_out << 42 << '\n';
+			expected += "42\n";
+			good &= check( static_cast<bool>( fs_out ), "append writes" );
+		}
+		return good & check( read_file( file_name ) == expected, "append" );
+	}
+} // namespace file_stream_test
@@ -0,0 +1,78 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Darrell Wright
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files( the "Software" ), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and / or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+#include "daw/io/async_file_stream.h"
+#include "file_stream_test.h"
+
+using namespace file_stream_test;
+
+namespace {
+	bool test( char const *file_name, daw::io::async_backend_type type ) {
+		std::string expected{};
+		bool good = true;
+		{
+			// Small buffers so that there are always writes in flight and the
+			// stream has to wait for a free buffer
+			auto fs_out = daw::make_async_file_stream(
+			  file_name, daw::io::file_open_flags::Write, 64, 3, type );
+			if( !fs_out ) {
+				std::perror( "File opening failed" );
+				exit( EXIT_FAILURE );
+			}
+			write_lines( fs_out, expected, 0, 10'000 );
+			good &= check_rewind( fs_out, expected );
+			// Nothing is left in flight after a flush
+			fs_out.flush( );
+			good &= check( read_file( file_name ) == expected, "flush" );
+		}
+		good &= check( read_file( file_name ) == expected, "contents" );
+		// Appends are written at the end offset rather than with O_APPEND
+		good &= check_append( file_name, expected, [&] {
+			return daw::make_async_file_stream(
+			  file_name, daw::io::file_open_flags::Append,
+			  daw::io::async_file_stream<char>::default_buffer_size,
+			  daw::io::async_file_stream<char>::default_buffer_count, type );
+		} );
+		good &= check_rewind_past_buffer( 64, [&] {
+			return daw::make_async_file_stream(
+			  file_name, daw::io::file_open_flags::Write, 64, 3, type );
+		} );
+		std::remove( file_name );
+		return good;
+	}
+} // namespace
+
+int main( int argc, char **argv ) {
+	char const *file_name = argc > 1 ? argv[1] : "async_file_stream_test.txt";
+	// io_uring where available, then the thread pool everywhere
+	bool good = test( file_name, daw::io::async_backend_type::automatic );
+	good &= test( file_name, daw::io::async_backend_type::thread_pool );
+	if( !good ) {
+		exit( EXIT_FAILURE );
+	}
+	puts( "Done" );
+	return EXIT_SUCCESS;
+}
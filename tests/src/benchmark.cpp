@@ -20,10 +20,14 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 // SOFTWARE.
 
+#include <charconv>
 #include <cstddef>
+#include <cstdio>
 #include <iomanip>
 #include <iostream>
+#include <random>
 #include <sstream>
+#include <vector>
 
 #ifndef _MSC_VER
 #include <daw/daw_utility.h>
@@ -31,8 +35,14 @@
 #include <daw/daw_benchmark.h>
 
 #include "./benchmark.h"
+#include "daw/io/async_file_stream.h"
 #include "daw/io/console_stream.h"
+#include "daw/io/direct_file_stream.h"
+#include "daw/io/double_buffered_file_stream.h"
+#include "daw/io/fd_stream.h"
+#include "daw/io/file_stream.h"
 #include "daw/io/memory_stream.h"
+#include "daw/io/printf.h"
 
 template<typename>
 struct get_format;
@@ -80,7 +90,7 @@ struct get_format<long> {
 };
 
 template<>
-struct get_format<int64_t> {
+struct get_format<long long> {
 	static constexpr daw::static_string_t<char, 4> get( ) {
 		return daw::static_string_t<char, 4>{"%lli"};
 	}
@@ -115,7 +125,7 @@ struct get_format<unsigned long> {
 };
 
 template<>
-struct get_format<uint64_t> {
+struct get_format<unsigned long long> {
 	static constexpr daw::static_string_t<char, 4> get( ) {
 		return daw::static_string_t<char, 4>{"%llu"};
 	}
@@ -200,6 +210,24 @@ struct test_t {
 		}
 	}
 
+	// No FILE lock, the benchmark is single threaded
+	template<typename Number>
+	void console_stream_unlocked_test( size_t count, Number number ) const {
+		for( size_t n = 0; n < count; ++n ) {
+			daw::DoNotOptimize( number );
+			daw::con_err_unlocked << number;
+		}
+	}
+
+	// One lock for the statement instead of one per write
+	template<typename Number>
+	void console_stream_locked_test( size_t count, Number number ) const {
+		for( size_t n = 0; n < count; ++n ) {
+			daw::DoNotOptimize( number );
+			daw::con_err.locked( ) << number;
+		}
+	}
+
 	template<typename Number, std::enable_if_t<std::is_integral_v<Number>,
 	                                           std::nullptr_t> = nullptr>
 	void printf_test( size_t count, Number number ) const {
@@ -221,6 +249,213 @@ struct test_t {
 	}
 };
 
+// Format a whole vector of numbers as CSV, one operator<< per value against a
+// single write_range
+template<typename Number, size_t N>
+void bench_range( char const ( &type_str )[N], std::vector<Number> const &values ) {
+	std::vector<char> buffer(
+	  values.size( ) *
+	  ( daw::io::impl::range_value_size<Number>( ) + 1 ) );
+
+	auto const t_stream = daw::benchmark( [&]( ) {
+		auto os =
+		  daw::io::make_memory_buffer_stream( buffer.data( ), buffer.size( ) );
+		for( auto const &v : values ) {
+			os << v << ',';
+		}
+		daw::DoNotOptimize( buffer );
+	} );
+	auto const t_range = daw::benchmark( [&]( ) {
+		auto os =
+		  daw::io::make_memory_buffer_stream( buffer.data( ), buffer.size( ) );
+		daw::io::write_range( os, values, ',' );
+		daw::DoNotOptimize( buffer );
+	} );
+	auto const count = static_cast<double>( values.size( ) );
+	std::cout << '"' << type_str << "\"," << values.size( ) << ','
+	          << daw::utility::format_seconds( t_stream / count ) << ','
+	          << daw::utility::format_seconds( t_range / count ) << '\n';
+}
+
+// Integers to CSV text: snprintf and std::to_chars one value at a time, the
+// scalar kernel one value at a time and write_range with the SIMD batches
+template<typename Integer, size_t N>
+void bench_integer_batch( char const ( &type_str )[N],
+                          std::vector<Integer> const &values ) {
+	constexpr size_t const value_size =
+	  daw::io::impl::range_value_size<Integer>( ) + 1;
+	std::vector<char> buffer( values.size( ) * value_size );
+
+	auto const t_snprintf = daw::benchmark( [&]( ) {
+		char *ptr = buffer.data( );
+		for( auto const &v : values ) {
+			if constexpr( std::is_signed_v<Integer> ) {
+				ptr += snprintf( ptr, value_size, "%lld,",
+				                 static_cast<long long>( v ) );
+			} else {
+				ptr += snprintf( ptr, value_size, "%llu,",
+				                 static_cast<unsigned long long>( v ) );
+			}
+		}
+		daw::DoNotOptimize( buffer );
+	} );
+	auto const t_to_chars = daw::benchmark( [&]( ) {
+		char *ptr = buffer.data( );
+		char *const last = ptr + buffer.size( );
+		for( auto const &v : values ) {
+			ptr = std::to_chars( ptr, last, v ).ptr;
+			*ptr++ = ',';
+		}
+		daw::DoNotOptimize( buffer );
+	} );
+	auto const t_scalar = daw::benchmark( [&]( ) {
+		char *ptr = buffer.data( );
+		for( auto const &v : values ) {
+			ptr = ostream_converters::impl::format_integer( ptr, v );
+			*ptr++ = ',';
+		}
+		daw::DoNotOptimize( buffer );
+	} );
+	auto const t_batch = daw::benchmark( [&]( ) {
+		auto os =
+		  daw::io::make_memory_buffer_stream( buffer.data( ), buffer.size( ) );
+		daw::io::write_range( os, values, ',' );
+		daw::DoNotOptimize( buffer );
+	} );
+	auto const count = static_cast<double>( values.size( ) );
+	std::cout << '"' << type_str << "\"," << values.size( ) << ','
+	          << daw::utility::format_seconds( t_snprintf / count ) << ','
+	          << daw::utility::format_seconds( t_to_chars / count ) << ','
+	          << daw::utility::format_seconds( t_scalar / count ) << ','
+	          << daw::utility::format_seconds( t_batch / count ) << '\n';
+}
+
+// The get_format strings through snprintf and daw::io::printf into a memory
+// stream
+template<typename Number, size_t N>
+void bench_printf( char const ( &type_str )[N],
+                   std::vector<Number> const &values ) {
+	// printf caches the parsed format by address, keep it in one place
+	static constexpr auto const format = get_format<Number>::get( );
+	constexpr int const precision = std::numeric_limits<Number>::max_digits10;
+	std::vector<char> buffer( 425 );
+
+	auto const t_snprintf = daw::benchmark( [&]( ) {
+		for( auto const &v : values ) {
+			if constexpr( std::is_floating_point_v<Number> ) {
+				snprintf( buffer.data( ), buffer.size( ), format.buffer, precision,
+				          static_cast<double>( v ) );
+			} else {
+				snprintf( buffer.data( ), buffer.size( ), format.buffer, v );
+			}
+			daw::DoNotOptimize( buffer );
+		}
+	} );
+	auto const t_printf = daw::benchmark( [&]( ) {
+		for( auto const &v : values ) {
+			auto os =
+			  daw::io::make_memory_buffer_stream( buffer.data( ), buffer.size( ) );
+			if constexpr( std::is_floating_point_v<Number> ) {
+				daw::io::printf( os, format.buffer, precision, v );
+			} else {
+				daw::io::printf( os, format.buffer, v );
+			}
+			daw::DoNotOptimize( buffer );
+		}
+	} );
+	auto const count = static_cast<double>( values.size( ) );
+	std::cout << '"' << type_str << "\"," << values.size( ) << ','
+	          << daw::utility::format_seconds( t_snprintf / count ) << ','
+	          << daw::utility::format_seconds( t_printf / count ) << '\n';
+}
+
+// console_stream_test and printf_test against the unlocked console stream and
+// the one that locks once per statement
+template<typename Number, size_t N>
+void bench_locking( char const ( &type_str )[N], size_t count,
+                    Number number ) {
+	test_t const t{};
+	auto const run = [&]( auto &&test ) {
+		auto const result = daw::benchmark( test );
+		fflush( stderr );
+		return result / static_cast<double>( count );
+	};
+	auto const t_printf = run( [&]( ) { t.printf_test( count, number ); } );
+	auto const t_console =
+	  run( [&]( ) { t.console_stream_test( count, number ); } );
+	auto const t_locked =
+	  run( [&]( ) { t.console_stream_locked_test( count, number ); } );
+	auto const t_unlocked =
+	  run( [&]( ) { t.console_stream_unlocked_test( count, number ); } );
+	std::cout << '"' << type_str << "\"," << count << ',' << number << ','
+	          << daw::utility::format_seconds( t_printf ) << ','
+	          << daw::utility::format_seconds( t_console ) << ','
+	          << daw::utility::format_seconds( t_locked ) << ','
+	          << daw::utility::format_seconds( t_unlocked ) << '\n';
+}
+
+// The lines written by file_test, count times to a file
+template<typename OutputStream>
+void file_test_workload( OutputStream &fs_out, size_t count ) {
+	for( size_t n = 0; n < count; ++n ) {
+		auto const i = static_cast<int>( n );
+		float const f = static_cast<float>( i ) * 1.2334f;
+		fs_out << "The number is: " << f << ". " << i << " times number is "
+		       << ( static_cast<float>( i ) * f ) << '\n';
+
+		double const d = static_cast<double>( i ) * 1.2334;
+		fs_out << "The number is: " << d << ". " << i << " times number is "
+		       << ( static_cast<double>( i ) * d ) << '\n';
+		fs_out << '\n';
+	}
+}
+
+void bench_file_streams( size_t count ) {
+	constexpr char const file_name[] = "benchmark_file_stream.txt";
+	auto const t_file_stream = daw::benchmark( [&]( ) {
+		auto fs_out = daw::make_file_stream( file_name );
+		file_test_workload( fs_out, count );
+	} );
+	auto const t_fd_stream = daw::benchmark( [&]( ) {
+		auto fs_out = daw::make_fd_stream( file_name );
+		file_test_workload( fs_out, count );
+	} );
+	auto const t_async_file_stream = daw::benchmark( [&]( ) {
+		auto fs_out = daw::make_async_file_stream( file_name );
+		file_test_workload( fs_out, count );
+	} );
+	auto const t_direct_file_stream = daw::benchmark( [&]( ) {
+		auto fs_out = daw::make_direct_file_stream( file_name );
+		file_test_workload( fs_out, count );
+	} );
+	auto const t_double_buffered_file_stream = daw::benchmark( [&]( ) {
+		auto fs_out = daw::make_double_buffered_file_stream( file_name );
+		file_test_workload( fs_out, count );
+	} );
+	std::remove( file_name );
+	auto const per_line = static_cast<double>( count * 3 );
+	std::cout << count * 3 << ','
+	          << daw::utility::format_seconds( t_file_stream / per_line ) << ','
+	          << daw::utility::format_seconds( t_fd_stream / per_line ) << ','
+	          << daw::utility::format_seconds( t_async_file_stream / per_line )
+	          << ','
+	          << daw::utility::format_seconds( t_direct_file_stream / per_line )
+	          << ','
+	          << daw::utility::format_seconds( t_double_buffered_file_stream /
+	                                           per_line )
+	          << '\n';
+}
+
+template<typename Number, typename Distribution>
+std::vector<Number> random_values( size_t count, Distribution dist ) {
+	std::mt19937_64 rng( 0 );
+	std::vector<Number> result( count );
+	for( auto &v : result ) {
+		v = static_cast<Number>( dist( rng ) );
+	}
+	return result;
+}
+
 int main( int argc, char ** ) {
 	std::ios_base::sync_with_stdio( false );
 	// constexpr size_t const count = 100'000;
@@ -305,48 +540,122 @@ int main( int argc, char ** ) {
 	daw::do_bench( "uint64_t", count, std::numeric_limits<uint64_t>::max( ),
 	               test_t{} );
 	daw::do_bench( "uint64_t", count, 0ULL, test_t{} );
+	daw::do_bench( "uint64_t", count, 12345678901234567890ULL, test_t{} );
+	daw::do_bench( "uint64_t", count, 1234567ULL, test_t{} );
 
 	daw::do_bench( "int64_t", count, std::numeric_limits<int64_t>::min( ),
 	               test_t{} );
 	daw::do_bench( "int64_t", count, std::numeric_limits<int64_t>::max( ),
 	               test_t{} );
 	daw::do_bench( "int64_t", count, 0LL, test_t{} );
+	daw::do_bench( "int64_t", count, -1234567890123456789LL, test_t{} );
+	daw::do_bench( "int64_t", count, 1234567LL, test_t{} );
 
 	daw::do_bench( "uint32_t", count, std::numeric_limits<uint32_t>::min( ),
 	               test_t{} );
 	daw::do_bench( "uint32_t", count, std::numeric_limits<uint32_t>::max( ),
 	               test_t{} );
 	daw::do_bench( "uint32_t", count, 0UL, test_t{} );
+	daw::do_bench( "uint32_t", count, static_cast<uint32_t>( 1234567890 ),
+	               test_t{} );
+	daw::do_bench( "uint32_t", count, static_cast<uint32_t>( 12345 ), test_t{} );
 
 	daw::do_bench( "int32_t", count, std::numeric_limits<int32_t>::min( ),
 	               test_t{} );
 	daw::do_bench( "int32_t", count, std::numeric_limits<int32_t>::max( ),
 	               test_t{} );
 	daw::do_bench( "int32_t", count, 0L, test_t{} );
+	daw::do_bench( "int32_t", count, static_cast<int32_t>( -1234567890 ),
+	               test_t{} );
+	daw::do_bench( "int32_t", count, static_cast<int32_t>( 12345 ), test_t{} );
 
 	daw::do_bench( "uint16_t", count, std::numeric_limits<uint16_t>::min( ),
 	               test_t{} );
 	daw::do_bench( "uint16_t", count, std::numeric_limits<uint16_t>::max( ),
 	               test_t{} );
 	daw::do_bench( "uint16_t", count, static_cast<uint16_t>( 0 ), test_t{} );
+	daw::do_bench( "uint16_t", count, static_cast<uint16_t>( 12345 ), test_t{} );
+	daw::do_bench( "uint16_t", count, static_cast<uint16_t>( 123 ), test_t{} );
 
 	daw::do_bench( "int16_t", count, std::numeric_limits<int16_t>::min( ),
 	               test_t{} );
 	daw::do_bench( "int16_t", count, std::numeric_limits<int16_t>::max( ),
 	               test_t{} );
 	daw::do_bench( "int16_t", count, static_cast<int16_t>( 0 ), test_t{} );
+	daw::do_bench( "int16_t", count, static_cast<int16_t>( -12345 ), test_t{} );
+	daw::do_bench( "int16_t", count, static_cast<int16_t>( 123 ), test_t{} );
 
 	daw::do_bench( "uint8_t", count, std::numeric_limits<uint8_t>::min( ),
 	               test_t{} );
 	daw::do_bench( "uint8_t", count, std::numeric_limits<uint8_t>::max( ),
 	               test_t{} );
 	daw::do_bench( "uint8_t", count, static_cast<uint8_t>( 0 ), test_t{} );
+	daw::do_bench( "uint8_t", count, static_cast<uint8_t>( 123 ), test_t{} );
+	daw::do_bench( "uint8_t", count, static_cast<uint8_t>( 12 ), test_t{} );
 
 	daw::do_bench( "int8_t", count, std::numeric_limits<int8_t>::min( ),
 	               test_t{} );
 	daw::do_bench( "int8_t", count, std::numeric_limits<int8_t>::max( ),
 	               test_t{} );
 	daw::do_bench( "int8_t", count, static_cast<int8_t>( 0 ), test_t{} );
+	daw::do_bench( "int8_t", count, static_cast<int8_t>( -123 ), test_t{} );
+	daw::do_bench( "int8_t", count, static_cast<int8_t>( 12 ), test_t{} );
+
+	std::cout << "\n\"type\",\"count\",\"operator<<(1)\",\"write_range(1)\"\n";
+	constexpr size_t const range_count = 1'000'000;
+	bench_range( "uint32_t",
+	             random_values<uint32_t>(
+	               range_count, std::uniform_int_distribution<uint32_t>( ) ) );
+	bench_range( "int64_t",
+	             random_values<int64_t>(
+	               range_count, std::uniform_int_distribution<int64_t>( ) ) );
+	bench_range( "double", random_values<double>(
+	                         range_count,
+	                         std::uniform_real_distribution<double>( -1e6, 1e6 ) ) );
+
+	std::cout << "\n\"type\",\"count\",\"snprintf(1)\",\"std::to_chars(1)\","
+	             "\"scalar(1)\",\"simd write_range(1)\"\n";
+	bench_integer_batch(
+	  "uint32_t", random_values<uint32_t>(
+	                range_count, std::uniform_int_distribution<uint32_t>( ) ) );
+	bench_integer_batch(
+	  "int32_t", random_values<int32_t>(
+	               range_count, std::uniform_int_distribution<int32_t>( ) ) );
+	bench_integer_batch(
+	  "uint64_t", random_values<uint64_t>(
+	                range_count, std::uniform_int_distribution<uint64_t>( ) ) );
+	bench_integer_batch(
+	  "int64_t", random_values<int64_t>(
+	               range_count, std::uniform_int_distribution<int64_t>( ) ) );
+	bench_integer_batch(
+	  "uint32_t < 1000",
+	  random_values<uint32_t>(
+	    range_count, std::uniform_int_distribution<uint32_t>( 0, 999 ) ) );
+
+	std::cout
+	  << "\n\"type\",\"count\",\"snprintf(1)\",\"daw::io::printf(1)\"\n";
+	bench_printf( "int32_t",
+	              random_values<int32_t>(
+	                range_count, std::uniform_int_distribution<int32_t>( ) ) );
+	bench_printf(
+	  "unsigned long long",
+	  random_values<unsigned long long>(
+	    range_count, std::uniform_int_distribution<unsigned long long>( ) ) );
+	bench_printf( "double", random_values<double>(
+	                          range_count,
+	                          std::uniform_real_distribution<double>( -1e6, 1e6 ) ) );
+
+	std::cout << "\n\"type\",\"count\",\"number\",\"printf(1)\",\"console "
+	             "stream(1)\",\"console stream locked( )(1)\",\"console "
+	             "stream unlocked(1)\"\n";
+	bench_locking( "double", count, 2.718281828459045 );
+	bench_locking( "int64_t", count, -1234567890123456789LL );
+	bench_locking( "uint32_t", count, static_cast<uint32_t>( 1234567890 ) );
+
+	std::cout << "\n\"lines\",\"file_stream(1)\",\"fd_stream(1)\","
+	             "\"async_file_stream(1)\",\"direct_file_stream(1)\","
+	             "\"double_buffered_file_stream(1)\"\n";
+	bench_file_streams( range_count );
 
 	return 0;
 }
@@ -0,0 +1,113 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2019 Darrell Wright
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files( the "Software" ), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and / or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+#include "daw/io/chunked_memory_stream.h"
+
+namespace {
+	struct iovec_t {
+		void *iov_base;
+		size_t iov_len;
+	};
+
+	bool check( bool b, char const *what ) {
+		if( !b ) {
+			printf( "Failed: %s\n", what );
+		}
+		return b;
+	}
+} // namespace
+
+int main( int, char ** ) {
+	auto os = daw::io::make_chunked_memory_stream<char, 16>( );
+	std::string expected{};
+	for( int n = 0; n < 100; ++n ) {
+		os << "The number is: " << n << ' ' << 1.5 * n << '\n';
+		expected += "The number is: " + std::to_string( n ) + ' ' +
+		            ( n % 2 == 0 ? std::to_string( 3 * n / 2 )
+		                         : std::to_string( 3 * n / 2 ) + ".5" ) +
+		            '\n';
+	}
+	bool good = check( os.size( ) == expected.size( ), "size" );
+	good &= check( os.to_os_string( ) == expected, "contents" );
+	good &= check( os.chunk_count( ) > 1, "chunk count" );
+
+	std::string gathered{};
+	iovec_t iovs[1024];
+	auto const iov_count = os.fill_iovecs( iovs, 1024 );
+	good &= check( iov_count == os.chunk_count( ), "iovec count" );
+	for( size_t n = 0; n < iov_count; ++n ) {
+		gathered.append( static_cast<char const *>( iovs[n].iov_base ),
+		                 iovs[n].iov_len );
+	}
+	good &= check( gathered == expected, "iovec contents" );
+
+	// Blocks are reused after a reset
+	os.reset( );
+	good &= check( os.empty( ) && os.chunk_count( ) == 0, "reset" );
+	os << std::string( 100, 'a' ) << 42;
+	good &= check( os.to_os_string( ) == std::string( 100, 'a' ) + "42",
+	               "after reset" );
+
+	// Output of a transaction that is not committed is dropped, including the
+	// blocks it started
+	auto const before = os.to_os_string( );
+	auto const chunks_before = os.chunk_count( );
+	{
+		auto tx = daw::io::make_stream_transaction( os );
+		os << "a partial record that spans blocks " << 1.5;
+	}
+	good &= check( os.to_os_string( ) == before &&
+	                 os.chunk_count( ) == chunks_before,
+	               "rewind" );
+	{
+		auto tx = daw::io::make_stream_transaction( os );
+		os << ",kept";
+		tx.commit( );
+	}
+	good &= check( os.to_os_string( ) == before + ",kept", "commit" );
+	{
+		auto tx = daw::io::make_stream_transaction( os );
+		os << ",dropped";
+		tx.rewind( );
+		os << ",retried";
+		tx.commit( );
+	}
+	good &= check( os.to_os_string( ) == before + ",kept,retried",
+	               "rewind and retry" );
+	os.reset( );
+	auto const empty_mark = os.mark( );
+	os << std::string( 100, 'b' );
+	os.rewind( empty_mark );
+	good &= check( os.empty( ) && os.chunk_count( ) == 0, "rewind to empty" );
+	os << 42;
+	good &= check( os.to_os_string( ) == "42", "after rewind to empty" );
+
+	if( !good ) {
+		return EXIT_FAILURE;
+	}
+	puts( "chunked_memory_stream passed" );
+	return EXIT_SUCCESS;
+}
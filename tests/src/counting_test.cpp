@@ -0,0 +1,100 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2019 Darrell Wright
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files( the "Software" ), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and / or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <random>
+
+#include "daw/io/counting_stream.h"
+#include "daw/io/memory_stream.h"
+#include "daw/io/static_string.h"
+
+namespace {
+	template<typename... Args>
+	constexpr size_t measure( Args const &... args ) {
+		auto os = daw::io::make_counting_stream( );
+		( os << ... << args );
+		return os.size( );
+	}
+
+	template<typename... Args>
+	constexpr size_t write( Args const &... args ) {
+		daw::static_string_t<char, 400> buffer{};
+		buffer.resize( buffer.capacity( ), false );
+		auto os =
+		  daw::io::make_memory_buffer_stream( buffer.data( ), buffer.size( ) );
+		( os << ... << args );
+		return os.size( );
+	}
+
+	template<typename T>
+	bool check_value( T value ) {
+		if( measure( value ) != write( value ) ) {
+			printf( "Size mismatch for %s: %zu != %zu\n",
+			        std::is_floating_point_v<T> ? "float" : "integer",
+			        measure( value ), write( value ) );
+			return false;
+		}
+		return true;
+	}
+
+	template<typename Float>
+	bool check_float( Float value ) {
+		return check_value( value ) && check_value( daw::as_scientific( value ) ) &&
+		       check_value( daw::as_general( value ) ) &&
+		       check_value( daw::as_fixed<3>( value ) );
+	}
+
+	template<typename Float, typename Bits>
+	Float from_bits( Bits bits ) {
+		Float result;
+		std::memcpy( &result, &bits, sizeof( Float ) );
+		return result;
+	}
+} // namespace
+
+static_assert( measure( "The answer is ", 42, ' ', -1.5, '\n' ) ==
+                 write( "The answer is ", 42, ' ', -1.5, '\n' ),
+               "" );
+static_assert( measure( true, false, daw::as_fixed<2>( 19.999 ) ) == 14, "" );
+static_assert( measure( std::numeric_limits<int64_t>::min( ) ) == 20, "" );
+static_assert( measure( 1e100, 0.001, 5e-324 ) == 16, "" );
+
+int main( int, char ** ) {
+	std::mt19937_64 rng( 0 );
+	bool good = true;
+	for( size_t n = 0; n < 1'000'000 && good; ++n ) {
+		auto const bits = rng( );
+		good &= check_value( static_cast<int64_t>( bits ) );
+		good &= check_value( static_cast<uint32_t>( bits >> ( bits % 32 ) ) );
+		good &= check_float( from_bits<double>( bits ) );
+		good &= check_float( from_bits<float>( static_cast<uint32_t>( bits ) ) );
+	}
+	if( !good ) {
+		return EXIT_FAILURE;
+	}
+	puts( "counting_stream passed" );
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,81 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Darrell Wright
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files( the "Software" ), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and / or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+#include "daw/io/direct_file_stream.h"
+#include "file_stream_test.h"
+
+using namespace file_stream_test;
+
+int main( int argc, char **argv ) {
+	char const *file_name = argc > 1 ? argv[1] : "direct_file_stream_test.txt";
+	std::string expected{};
+	bool good = true;
+	{
+		// The smallest buffer, one block, so that it is written often and long
+		// strings are written around it
+		auto fs_out = daw::make_direct_file_stream(
+		  file_name, daw::io::file_open_flags::Write, 1 );
+		if( !fs_out ) {
+			std::perror( "File opening failed" );
+			exit( EXIT_FAILURE );
+		}
+		printf( "O_DIRECT: %s\n", fs_out.is_direct( ) ? "yes" : "no" );
+		std::string const long_str( 10'000, 'x' );
+		for( int n = 0; n < 10; ++n ) {
+			write_lines( fs_out, expected, n * 100, n * 100 + 100 );
+			fs_out << long_str;
+			expected += long_str;
+			// Only whole blocks are written, the partial one stays buffered
+			fs_out.flush( );
+		}
+		good &= check_rewind( fs_out, expected );
+		good &= check( static_cast<bool>( fs_out ), "writes" );
+	}
+	// The padding of the last block is cut off
+	good &= check( read_file( file_name ) == expected, "contents" );
+	// The partial last block is read back before appending to it
+	good &= check_append( file_name, expected, [&] {
+		return daw::make_direct_file_stream( file_name,
+		                                     daw::io::file_open_flags::Append );
+	} );
+	{
+		// Nothing written leaves an empty file
+		auto fs_out = daw::make_direct_file_stream( file_name );
+	}
+	good &= check( read_file( file_name ).empty( ), "empty" );
+	// A one block buffer, rewinding after 4KiB went to the file fails
+	good &= check_rewind_past_buffer( 4096, [&] {
+		return daw::make_direct_file_stream(
+		  file_name, daw::io::file_open_flags::Write, 1 );
+	} );
+	std::remove( file_name );
+
+	if( !good ) {
+		exit( EXIT_FAILURE );
+	}
+	puts( "Done" );
+	return EXIT_SUCCESS;
+}
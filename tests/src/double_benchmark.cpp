@@ -21,6 +21,7 @@
 // SOFTWARE.
 
 #include <cstddef>
+#include <cstdio>
 #include <iomanip>
 #include <iostream>
 #include <sstream>
@@ -32,7 +33,9 @@
 
 #include "./benchmark.h"
 #include "daw/io/console_stream.h"
+#include "daw/io/format.h"
 #include "daw/io/memory_stream.h"
+#include "daw/io/ostream_converters.h"
 
 struct test_t {
 	void stringstream_test( size_t count, double number ) const {
@@ -105,11 +108,154 @@ struct test_t {
 	}
 };
 
+// Compare the number to string conversion alone, without any stream
+// overhead.  The shortest round trip output against the max_digits10 path
+// and snprintf( "%.17g" ), then as_fixed<2> against snprintf( "%.2f" )
+template<size_t N, typename Float>
+void bench_conversion( char const ( &type_str )[N], size_t count,
+                       Float number ) {
+	using ostream_converters::to_os_string;
+	daw::DoNotOptimize( count );
+	auto const t_shortest = daw::benchmark( [&]( ) {
+		for( size_t n = 0; n < count; ++n ) {
+			daw::DoNotOptimize( number );
+			auto str = to_os_string<char>( number );
+			daw::DoNotOptimize( str );
+		}
+	} );
+	auto const t_digits = daw::benchmark( [&]( ) {
+		for( size_t n = 0; n < count; ++n ) {
+			daw::DoNotOptimize( number );
+			auto str = to_os_string<char>(
+			  number, std::numeric_limits<Float>::max_digits10 );
+			daw::DoNotOptimize( str );
+		}
+	} );
+	auto const t_snprintf = daw::benchmark( [&]( ) {
+		daw::static_string_t<char, 32> buffer{};
+		buffer.resize( buffer.capacity( ), false );
+		for( size_t n = 0; n < count; ++n ) {
+			daw::DoNotOptimize( number );
+			snprintf( buffer.data( ), buffer.capacity( ), "%.*g",
+			          std::numeric_limits<Float>::max_digits10,
+			          static_cast<double>( number ) );
+			daw::DoNotOptimize( buffer );
+		}
+	} );
+	auto const t_fixed = daw::benchmark( [&]( ) {
+		for( size_t n = 0; n < count; ++n ) {
+			daw::DoNotOptimize( number );
+			auto str = to_os_string<char>( daw::as_fixed<2>( number ) );
+			daw::DoNotOptimize( str );
+		}
+	} );
+	auto const t_snprintf_fixed = daw::benchmark( [&]( ) {
+		daw::static_string_t<char, 325> buffer{};
+		buffer.resize( buffer.capacity( ), false );
+		for( size_t n = 0; n < count; ++n ) {
+			daw::DoNotOptimize( number );
+			snprintf( buffer.data( ), buffer.capacity( ), "%.2f",
+			          static_cast<double>( number ) );
+			daw::DoNotOptimize( buffer );
+		}
+	} );
+	std::cout << '"' << type_str << "\"," << count << ','
+	          << std::setprecision( std::numeric_limits<Float>::max_digits10 )
+	          << number;
+	std::cout << ','
+	          << daw::utility::format_seconds( t_shortest /
+	                                           static_cast<double>( count ) );
+	std::cout << ','
+	          << daw::utility::format_seconds( t_digits /
+	                                           static_cast<double>( count ) );
+	std::cout << ','
+	          << daw::utility::format_seconds( t_snprintf /
+	                                           static_cast<double>( count ) );
+	std::cout << ','
+	          << daw::utility::format_seconds( t_fixed /
+	                                           static_cast<double>( count ) );
+	std::cout << ','
+	          << daw::utility::format_seconds( t_snprintf_fixed /
+	                                           static_cast<double>( count ) );
+	std::cout << std::endl;
+}
+
+// The benchmark statement as a chain of operator<< against a single
+// daw::io::write and a compile time format string
+void bench_write( size_t count, double number ) {
+	daw::static_string_t<char, 325> buffer{};
+	buffer.resize( buffer.capacity( ), false );
+	auto const t_stream = daw::benchmark( [&]( ) {
+		for( size_t n = 0; n < count; ++n ) {
+			daw::DoNotOptimize( number );
+			auto ss =
+			  ::daw::io::make_memory_buffer_stream( buffer.data( ), buffer.size( ) );
+			ss << "The answer to the meaning of life is " << count << ' ' << number
+			   << '\n';
+			daw::DoNotOptimize( buffer );
+		}
+	} );
+	auto const t_write = daw::benchmark( [&]( ) {
+		for( size_t n = 0; n < count; ++n ) {
+			daw::DoNotOptimize( number );
+			auto ss =
+			  ::daw::io::make_memory_buffer_stream( buffer.data( ), buffer.size( ) );
+			::daw::io::write( ss, "The answer to the meaning of life is ", count,
+			                  ' ', number, '\n' );
+			daw::DoNotOptimize( buffer );
+		}
+	} );
+	auto const t_format = daw::benchmark( [&]( ) {
+		for( size_t n = 0; n < count; ++n ) {
+			daw::DoNotOptimize( number );
+			auto ss =
+			  ::daw::io::make_memory_buffer_stream( buffer.data( ), buffer.size( ) );
+			::daw::io::format(
+			  ss, DAW_IO_FMT( "The answer to the meaning of life is {} {}\n" ),
+			  count, number );
+			daw::DoNotOptimize( buffer );
+		}
+	} );
+	std::cout << "\n\"count\",\"number\",\"operator<<(1)\",\"write(1)\","
+	             "\"format(1)\"\n";
+	std::cout << count << ',' << number << ','
+	          << daw::utility::format_seconds( t_stream /
+	                                           static_cast<double>( count ) )
+	          << ','
+	          << daw::utility::format_seconds( t_write /
+	                                           static_cast<double>( count ) )
+	          << ','
+	          << daw::utility::format_seconds( t_format /
+	                                           static_cast<double>( count ) )
+	          << std::endl;
+}
+
 int main( int argc, char ** ) {
 	std::ios_base::sync_with_stdio( false );
 	size_t count = 100'000;
 	daw::do_bench_header( );
 	daw::do_bench( "double", count, 42.0, test_t{} );
+	bench_write( count, 42.0 );
+
+	std::cout << "\n\"type\",\"count\",\"number\",\"shortest(1)\",\"max_"
+	             "digits10(1)\",\"snprintf(1)\",\"as_fixed<2>(1)\",\"snprintf "
+	             "%.2f(1)\"\n";
+	bench_conversion( "double", count, 42.0 );
+	bench_conversion( "double", count, 0.1234 );
+	bench_conversion( "double", count, 2.718281828459045 );
+	bench_conversion( "double", count, 123456.0435333 );
+	bench_conversion( "double", count, 19.99 );
+	bench_conversion( "double", count, 1.0 / 3.0 );
+	bench_conversion( "double", count, std::numeric_limits<double>::max( ) );
+	bench_conversion( "double", count, std::numeric_limits<double>::min( ) );
+	bench_conversion( "double", count,
+	                  std::numeric_limits<double>::denorm_min( ) );
+	bench_conversion( "float", count, 42.0f );
+	bench_conversion( "float", count, 0.1234f );
+	bench_conversion( "float", count, 2.7182817f );
+	bench_conversion( "float", count, 1.0f / 3.0f );
+	bench_conversion( "float", count, std::numeric_limits<float>::max( ) );
+	bench_conversion( "float", count, std::numeric_limits<float>::denorm_min( ) );
 	/*
 	daw::do_bench( "double", count, 0.1234, test_t{} );
 	daw::do_bench( "double", count, 2.718281828459045, test_t{} );
@@ -0,0 +1,84 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Darrell Wright
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files( the "Software" ), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and / or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+#include <unistd.h>
+
+#include "daw/io/double_buffered_file_stream.h"
+#include "file_stream_test.h"
+
+using namespace file_stream_test;
+
+int main( int argc, char **argv ) {
+	char const *file_name =
+	  argc > 1 ? argv[1] : "double_buffered_file_stream_test.txt";
+	std::string expected{};
+	bool good = true;
+	{
+		// Small buffers so that they are handed over often and long strings
+		// span several
+		auto fs_out = daw::make_double_buffered_file_stream(
+		  file_name, daw::io::file_open_flags::Write, 16 );
+		if( !fs_out ) {
+			std::perror( "File opening failed" );
+			exit( EXIT_FAILURE );
+		}
+		write_lines( fs_out, expected, 0, 1'000 );
+		// Everything is in the file after a flush
+		fs_out.flush( true );
+		good &= check( read_file( file_name ) == expected, "flush" );
+		fs_out << std::string( 1'000, 'x' );
+		expected += std::string( 1'000, 'x' );
+		good &= check_rewind( fs_out, expected );
+	}
+	good &= check( read_file( file_name ) == expected, "contents" );
+	{
+		// More buffers, moved while there are writes outstanding
+		auto fs_out = daw::make_double_buffered_file_stream(
+		  file_name, daw::io::file_open_flags::Append, 64, 4 );
+		write_lines( fs_out, expected, 0, 500 );
+		auto fs_out2 = std::move( fs_out );
+		write_lines( fs_out2, expected, 500, 1'000 );
+		good &= check( !fs_out && static_cast<bool>( fs_out2 ), "move" );
+	}
+	good &= check( read_file( file_name ) == expected, "moved" );
+	good &= check_append( file_name, expected, [&] {
+		return daw::make_double_buffered_file_stream(
+		  file_name, daw::io::file_open_flags::Append );
+	} );
+	good &= check_rewind_past_buffer( 16, [&] {
+		return daw::make_double_buffered_file_stream(
+		  file_name, daw::io::file_open_flags::Write, 16 );
+	} );
+	std::remove( file_name );
+
+	if( !good ) {
+		exit( EXIT_FAILURE );
+	}
+	// Not owned, so stdout is left open
+	auto fs_out = daw::make_double_buffered_file_stream( STDOUT_FILENO );
+	fs_out << "Done\n";
+	return EXIT_SUCCESS;
+}
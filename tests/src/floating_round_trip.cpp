@@ -20,8 +20,16 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 // SOFTWARE.
 
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
 #include <cstdlib>
+#include <cstring>
 #include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
 
 #include "daw/io/memory_stream.h"
 #include "daw/io/static_string.h"
@@ -65,15 +73,141 @@ void test_round_trip( char const ( &type )[N], Float f, bool show_all = true ) {
 	}
 }
 
-void t2( ) {
-	double d_orig = 0.00012208391547875944; // Known bad starting point
-	for( size_t i = 1; i <= 10000000000; ++i ) {
-		test_round_trip( "double", d_orig, false );
-		d_orig += 0.00012208391547875944;
+template<typename Float>
+struct float_bits;
+
+template<>
+struct float_bits<float> {
+	using type = uint32_t;
+};
+
+template<>
+struct float_bits<double> {
+	using type = uint64_t;
+};
+
+template<typename Float>
+using float_bits_t = typename float_bits<Float>::type;
+
+struct verify_result {
+	uint64_t checked = 0;
+	uint64_t mismatches = 0;
+	uint64_t first_mismatch = 0;
+};
+
+// Each thread writes through its own memory_stream into its own buffer and
+// reads the value back with strtof/strtod
+template<typename Float>
+class round_trip_checker {
+	std::array<char, 64> m_buffer{};
+	verify_result m_result{};
+
+public:
+	void operator( )( float_bits_t<Float> bits ) {
+		Float f{};
+		std::memcpy( &f, &bits, sizeof( f ) );
+		auto os =
+		  daw::io::make_memory_buffer_stream( m_buffer.data( ), m_buffer.size( ) );
+		os << f;
+		auto const size = os.size( );
+		m_buffer[size] = '\0';
+		++m_result.checked;
+
+		bool good = false;
+		if( f != f ) {
+			good = std::strcmp( m_buffer.data( ), "nan" ) == 0;
+		} else {
+			char *end = nullptr;
+			good = conv<Float>( m_buffer.data( ), &end ) == f &&
+			       end == m_buffer.data( ) + size;
+		}
+		if( !good && m_result.mismatches++ == 0 ) {
+			m_result.first_mismatch = bits;
+		}
+	}
+
+	verify_result const &result( ) const noexcept {
+		return m_result;
+	}
+};
+
+template<typename Work>
+verify_result run_parallel( char const *name, size_t thread_count,
+                            Work work ) {
+	std::vector<verify_result> results( thread_count );
+	std::vector<std::thread> threads{};
+	threads.reserve( thread_count );
+	auto const start = std::chrono::steady_clock::now( );
+	for( size_t t = 0; t < thread_count; ++t ) {
+		threads.emplace_back( [&results, &work, t]( ) { results[t] = work( t ); } );
 	}
+	for( auto &th : threads ) {
+		th.join( );
+	}
+	std::chrono::duration<double> const elapsed =
+	  std::chrono::steady_clock::now( ) - start;
+
+	verify_result total{};
+	for( auto const &r : results ) {
+		if( total.mismatches == 0 && r.mismatches > 0 ) {
+			total.first_mismatch = r.first_mismatch;
+		}
+		total.checked += r.checked;
+		total.mismatches += r.mismatches;
+	}
+	std::cout << name << ": " << total.checked << " values on " << thread_count
+	          << " threads, " << total.mismatches << " mismatches, "
+	          << elapsed.count( ) << "s, "
+	          << static_cast<double>( total.checked ) / elapsed.count( ) / 1e6
+	          << "M values/s\n";
+	if( total.mismatches > 0 ) {
+		std::cout << "  first mismatch bits 0x" << std::hex << total.first_mismatch
+		          << std::dec << '\n';
+	}
+	return total;
+}
+
+// Every float, split into one contiguous block per thread
+verify_result verify_all_floats( size_t thread_count ) {
+	return run_parallel(
+	  "float32 exhaustive", thread_count, [thread_count]( size_t t ) {
+		  uint64_t const block = ( 1ULL << 32U ) / thread_count;
+		  uint64_t const first = block * t;
+		  uint64_t const last =
+		    t + 1 == thread_count ? ( 1ULL << 32U ) : first + block;
+		  round_trip_checker<float> check{};
+		  for( uint64_t bits = first; bits < last; ++bits ) {
+			  check( static_cast<uint32_t>( bits ) );
+		  }
+		  return check.result( );
+	  } );
+}
+
+// The mantissas at either end of every exponent, where the rounding interval
+// is asymmetric and the subnormal handling lives, then random bit patterns
+verify_result verify_sampled_doubles( size_t thread_count,
+                                      uint64_t random_count ) {
+	return run_parallel(
+	  "float64 sampled", thread_count, [thread_count, random_count]( size_t t ) {
+		  constexpr uint64_t const edge_count = 4096;
+		  constexpr uint64_t const mantissa_mask = ( 1ULL << 52U ) - 1ULL;
+		  round_trip_checker<double> check{};
+		  for( uint64_t exponent = t; exponent < 2048; exponent += thread_count ) {
+			  for( uint64_t m = 0; m < edge_count; ++m ) {
+				  check( ( exponent << 52U ) | m );
+				  check( ( exponent << 52U ) | ( mantissa_mask - m ) );
+			  }
+		  }
+		  std::mt19937_64 rng( t );
+		  for( uint64_t n = t; n < random_count; n += thread_count ) {
+			  check( rng( ) );
+		  }
+		  return check.result( );
+	  } );
 }
 
-int main( ) {
+// floating_round_trip [double_samples]
+int main( int argc, char **argv ) {
 	std::cout << "double epsilon   -> " << std::numeric_limits<double>::epsilon( )
 	          << '\n';
 	std::cout << "double min       -> " << std::numeric_limits<double>::min( )
@@ -128,7 +262,16 @@ int main( ) {
 	test_round_trip( "float", std::numeric_limits<float>::min( ) +
 	                            ( std::numeric_limits<float>::min( ) * 10.0f ) );
 
-	// testing potential bad range
-	t2( );
-	return 0;
+	uint64_t const double_samples =
+	  argc > 1 ? std::strtoull( argv[1], nullptr, 10 ) : 1'000'000'000ULL;
+	size_t const thread_count =
+	  std::max( std::thread::hardware_concurrency( ), 1U );
+
+	std::cout << '\n';
+	auto const floats = verify_all_floats( thread_count );
+	auto const doubles = verify_sampled_doubles( thread_count, double_samples );
+	if( floats.mismatches > 0 || doubles.mismatches > 0 ) {
+		return EXIT_FAILURE;
+	}
+	return EXIT_SUCCESS;
 }
@@ -0,0 +1,71 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2019 Darrell Wright
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files( the "Software" ), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and / or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "daw/io/console_stream.h"
+#include "daw/io/counting_stream.h"
+#include "daw/io/format.h"
+#include "daw/io/memory_stream.h"
+#include "daw/io/static_string.h"
+
+namespace {
+	template<size_t BUFF_SIZE = 100, typename Format, typename... Args>
+	constexpr auto test( Format fmt, Args const &... args ) {
+		daw::static_string_t<char, BUFF_SIZE> buffer{};
+		buffer.resize( buffer.capacity( ), false );
+
+		auto buff_os =
+		  ::daw::io::make_memory_buffer_stream( buffer.data( ), buffer.size( ) );
+
+		::daw::io::format( buff_os, fmt, args... );
+		buffer.resize( buff_os.size( ), false );
+		return buffer;
+	}
+
+	template<typename Format, typename... Args>
+	constexpr size_t measure( Format fmt, Args const &... args ) {
+		auto os = ::daw::io::make_counting_stream( );
+		::daw::io::format( os, fmt, args... );
+		return os.size( );
+	}
+} // namespace
+
+static_assert( test( DAW_IO_FMT( "value={} at {}\n" ), 42, 1.5 ) ==
+                 "value=42 at 1.5\n",
+               "" );
+static_assert( test( DAW_IO_FMT( "{}{}{}" ), 'a', true, -1 ) == "atrue-1", "" );
+static_assert( test( DAW_IO_FMT( "{{}} {}}}" ), 5 ) == "{} 5}", "" );
+static_assert( test( DAW_IO_FMT( "no holes" ) ) == "no holes", "" );
+// Smaller than the combined maximum size, written one piece at a time
+static_assert( test<16>( DAW_IO_FMT( "value={} at {}\n" ), 42, 1.5 ) ==
+                 "value=42 at 1.5\n",
+               "" );
+static_assert( measure( DAW_IO_FMT( "value={} at {}\n" ), 42, 1.5 ) == 16, "" );
+
+int main( int, char ** ) {
+	daw::io::format( daw::con_out, DAW_IO_FMT( "The answer is {} {}\n" ), 42,
+	                 daw::as_fixed<2>( 3.14159 ) );
+#if defined( __cpp_nontype_template_args ) &&                                 \
+  __cpp_nontype_template_args >= 201911L
+	daw::io::format<"The answer is {}\n">( daw::con_out, 42 );
+#endif
+	return 0;
+}
@@ -20,6 +20,9 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 // SOFTWARE.
 
+#include <array>
+#include <utility>
+
 #include "daw/io/console_stream.h"
 
 #include "daw/io/memory_stream.h"
@@ -56,8 +59,115 @@ namespace {
 		buffer.shrink_to_fit( );
 		return buffer;
 	}
+
+	template<typename Container>
+	constexpr auto test_range( Container const &values ) {
+		daw::static_string_t<char, 100> buffer{};
+		buffer.resize( buffer.capacity( ), false );
+
+		auto buff_os =
+		  ::daw::io::make_memory_buffer_stream( buffer.data( ), buffer.size( ) );
+
+		::daw::io::write_range( buff_os, values, ", " );
+		buffer.resize( buff_os.size( ), false );
+		return buffer;
+	}
+
+	// Values are formatted straight into the buffer when it has room for the
+	// longest result and through to_os_string when it does not
+	template<size_t BUFF_SIZE>
+	constexpr auto test_direct( ) {
+		daw::static_string_t<char, BUFF_SIZE> buffer{};
+		buffer.resize( buffer.capacity( ), false );
+
+		auto buff_os =
+		  ::daw::io::make_memory_buffer_stream( buffer.data( ), buffer.size( ) );
+
+		buff_os << -123 << ' ' << daw::as_fixed<1>( 2.25 ) << true;
+		buffer.resize( buff_os.size( ), false );
+		return buffer;
+	}
+
+	// Writes that do not fit are cut short and counted
+	constexpr auto test_truncate( ) {
+		daw::static_string_t<char, 10> buffer{};
+		buffer.resize( buffer.capacity( ), false );
+
+		auto buff_os =
+		  ::daw::io::make_memory_buffer_stream<daw::io::overflow_policy::truncate>(
+		    buffer.data( ), buffer.size( ) );
+
+		buff_os << "The number is " << 42 << '!';
+		buffer.resize( buff_os.size( ), false );
+		return std::pair( buffer, buff_os.dropped( ) );
+	}
+
+	// A record is dropped after it is found to be invalid part way through
+	template<daw::io::overflow_policy Policy, size_t BUFF_SIZE>
+	constexpr auto test_rewind( ) {
+		daw::static_string_t<char, BUFF_SIZE> buffer{};
+		buffer.resize( buffer.capacity( ), false );
+
+		auto buff_os = ::daw::io::make_memory_buffer_stream<Policy>(
+		  buffer.data( ), buffer.size( ) );
+
+		buff_os << "a=1";
+		auto const m = buff_os.mark( );
+		buff_os << ",b=" << 12345678;
+		buff_os.rewind( m );
+		buff_os << ",c=3";
+		buffer.resize( buff_os.size( ), false );
+		return std::pair( buffer, buff_os.dropped( ) );
+	}
+
+	// All the arguments with one capacity check, or one at a time when the
+	// buffer is smaller than their combined maximum size
+	template<size_t BUFF_SIZE>
+	constexpr auto test_write( ) {
+		daw::static_string_t<char, BUFF_SIZE> buffer{};
+		buffer.resize( buffer.capacity( ), false );
+
+		auto buff_os =
+		  ::daw::io::make_memory_buffer_stream( buffer.data( ), buffer.size( ) );
+
+		::daw::io::write( buff_os, "The answer is ", 42, ' ', 0.5, A{},
+		                  daw::string_view( "!\n" ) );
+		buffer.resize( buff_os.size( ), false );
+		return buffer;
+	}
 } // namespace
 
+static_assert( test_write<100>( ) == "The answer is 42 0.5A!\n", "" );
+static_assert( test_write<23>( ) == "The answer is 42 0.5A!\n", "" );
+
+static_assert(
+  test_rewind<daw::io::overflow_policy::throw_exception, 20>( ).first ==
+    "a=1,c=3",
+  "" );
+// The characters dropped after the mark are forgotten too
+static_assert( test_rewind<daw::io::overflow_policy::truncate, 10>( ).first ==
+                 "a=1,c=3",
+               "" );
+static_assert( test_rewind<daw::io::overflow_policy::truncate, 10>( ).second ==
+                 0,
+               "" );
+
+static_assert( test_truncate( ).first == "The number", "" );
+static_assert( test_truncate( ).second == 7, "" );
+
+static_assert(
+  daw::io::impl::has_prepare_commit_v<daw::io::memory_stream<char>>, "" );
+static_assert( test_direct<100>( ) == "-123 2.2true", "" );
+static_assert( test_direct<12>( ) == "-123 2.2true", "" );
+
+static_assert( test_range( std::array<int, 4>{1, -20, 300, 0} ) ==
+                 "1, -20, 300, 0",
+               "" );
+static_assert( test_range( std::array<double, 3>{0.5, -1e100, 42.0} ) ==
+                 "0.5, -1e100, 42",
+               "" );
+static_assert( test_range( std::array<uint64_t, 0>{} ) == "", "" );
+
 static constexpr auto const test_result = test( 1234560.435333 );
 static constexpr auto const test_result2 = test( 1234560.435333f );
 
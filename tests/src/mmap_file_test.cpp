@@ -0,0 +1,84 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2019 Darrell Wright
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files( the "Software" ), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and / or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+#include "daw/io/mmap_file_stream.h"
+#include "file_stream_test.h"
+
+using namespace file_stream_test;
+
+int main( int argc, char **argv ) {
+	char const *file_name = argc > 1 ? argv[1] : "mmap_file_test.txt";
+	std::string expected{};
+	bool good = true;
+	{
+		// A one page extent so that the file is grown and remapped many times
+		auto fs_out = daw::make_mmap_file_stream( file_name,
+		                                          daw::io::file_open_flags::Write, 1 );
+		if( !fs_out ) {
+			std::perror( "File opening failed" );
+			exit( EXIT_FAILURE );
+		}
+		write_lines( fs_out, expected, 0, 10'000 );
+		good &= check_rewind( fs_out, expected );
+	}
+	good &= check( read_file( file_name ) == expected, "contents" );
+	{
+		auto fs_out =
+		  daw::make_mmap_file_stream( file_name, daw::io::file_open_flags::Append );
+		{
+			// Rewound past the size the file was opened with
+			auto tx = daw::io::make_stream_transaction( fs_out );
+			fs_out << "Not kept\n";
+		}
+		{
+			// Dropped even after being written back with flush( )
+			auto tx = daw::io::make_stream_transaction( fs_out );
+			std::string ignored{};
+			write_lines( fs_out, ignored, 0, 1'000 );
+			fs_out.flush( );
+			write_lines( fs_out, ignored, 0, 1'000 );
+			good &= check( tx.rewind( ), "rewind after flush" );
+		}
+		fs_out << "Done\n";
+		expected += "Done\n";
+		good &= check( fs_out.size( ) == expected.size( ), "append size" );
+	}
+	good &= check( read_file( file_name ) == expected, "append contents" );
+	{
+		// The reserved space is cut off on close
+		auto fs_out = daw::make_mmap_file_stream( file_name );
+		fs_out.reserve( 1'000'000 );
+		fs_out << 42;
+	}
+	good &= check( read_file( file_name ) == "42", "reserve" );
+	std::remove( file_name );
+
+	if( !good ) {
+		exit( EXIT_FAILURE );
+	}
+	puts( "Done" );
+	return EXIT_SUCCESS;
+}
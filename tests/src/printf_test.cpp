@@ -0,0 +1,153 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2019 Darrell Wright
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files( the "Software" ), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and / or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <string>
+
+#include <daw/daw_string_view.h>
+
+#include "daw/io/console_stream.h"
+#include "daw/io/memory_stream.h"
+#include "daw/io/printf.h"
+
+namespace {
+	bool failed = false;
+
+	// daw::io::printf, or printf_uncached, must match std::snprintf
+	template<bool Uncached = false, typename... Args>
+	void test( char const *fmt, Args const &... args ) {
+		char expected[1024];
+		std::snprintf( expected, sizeof( expected ), fmt, args... );
+
+		char buffer[1024];
+		auto buff_os =
+		  daw::io::make_memory_buffer_stream( buffer, sizeof( buffer ) );
+		if( Uncached ) {
+			daw::io::printf_uncached( buff_os, fmt, args... );
+		} else {
+			daw::io::printf( buff_os, fmt, args... );
+		}
+
+		if( buff_os.size( ) != std::strlen( expected ) ||
+		    std::memcmp( buffer, expected, buff_os.size( ) ) != 0 ) {
+			failed = true;
+			daw::con_err << "printf( \"" << fmt << "\" ) expected \"" << expected
+			             << "\" got \""
+			             << daw::string_view( buffer, buff_os.size( ) ) << "\"\n";
+		}
+	}
+
+	void test_integers( ) {
+		test( "%d %i %u %%", 42, -42, 42U );
+		test( "[%5d][%-5d][%05d][%+d][% d]", 7, -7, -7, 7, 7 );
+		test( "[%.3d][%8.3d][%-8.3d][%.0d]", 7, -7, 7, 0 );
+		test( "%x %X %#x %#X %o %#o %#.0o", 255U, 255U, 255U, 0U, 8U, 8U, 0U );
+		test( "%u %x", -1, -1 );
+		test( "%hhd %hhu %hd %hu", 300, 300, 70000, 70000 );
+		test( "%ld %lld %lu %zu", -5L, std::numeric_limits<long long>::min( ),
+		      std::numeric_limits<unsigned long>::max( ), sizeof( int ) );
+		test( "[%*d][%-*d][%*d]", 5, 3, 5, 3, -5, 3 );
+	}
+
+	void test_strings( ) {
+		test( "[%s][%10s][%-10s][%.2s][%c][%3c]", "abc", "abc", "abc", "abcdef",
+		      'x', 'y' );
+		test( "[%p][%p]", static_cast<void const *>( "" ),
+		      static_cast<void const *>( nullptr ) );
+		test( "unknown %y stays" );
+	}
+
+	// Formats built at runtime at the same address, of the same length too
+	void test_reused_format( ) {
+		std::string fmt{};
+		fmt.reserve( 32 );
+		char const *const formats[] = {"%d!", "%x!", "[%5d]", "%o", "%-6d|"};
+		for( size_t n = 0; n < 3; ++n ) {
+			for( auto f : formats ) {
+				fmt = f;
+				test<true>( fmt.c_str( ), 42 );
+			}
+		}
+	}
+
+	void test_floats( ) {
+		double const values[] = {0.0,
+		                         1.0,
+		                         0.5,
+		                         2.5,
+		                         0.1,
+		                         123.456,
+		                         1e-5,
+		                         9.9999995,
+		                         999999.5,
+		                         1e22,
+		                         1e-7,
+		                         1e-12,
+		                         1e-20,
+		                         1.0 / 3.0,
+		                         std::numeric_limits<double>::max( ),
+		                         std::numeric_limits<double>::min( ),
+		                         std::numeric_limits<double>::denorm_min( ),
+		                         std::numeric_limits<double>::infinity( ),
+		                         std::numeric_limits<double>::quiet_NaN( )};
+		char const *const formats[] = {
+		  "%f",  "%.0f", "%#.0f", "%.3f", "%e",   "%.0e",  "%.3e",  "%E",
+		  "%g",  "%G",   "%.0g",  "%.3g", "%.17g", "%#.3g", "%a",   "%.1a",
+		  "%A",  "%.16e", "[%+012.3f]", "[%-12.3e]", "[% g]", "[%012g]",
+		  "[%20.10e]"};
+		for( auto v : values ) {
+			for( auto fmt : formats ) {
+				test( fmt, v );
+				test( fmt, -v );
+			}
+		}
+		test( "%.*f %.*e", 2, 3.14159, 10, 3.14159 );
+
+		// The nearest double to a power of ten is often just below it
+		for( int e = -300; e <= 300; ++e ) {
+			auto const v = std::strtod( ( "1e" + std::to_string( e ) ).c_str( ),
+			                            nullptr );
+			test( "%.17g %.16e %.0e %g", v, v, v, v );
+		}
+
+		std::mt19937_64 rng( 0 );
+		std::uniform_real_distribution<double> dist( -1e10, 1e10 );
+		for( size_t n = 0; n < 10'000; ++n ) {
+			auto const v = dist( rng );
+			test( "%f %.10e %g %.15g %a", v, v, v, v, v );
+		}
+	}
+} // namespace
+
+int main( int, char ** ) {
+	test_integers( );
+	test_strings( );
+	test_reused_format( );
+	test_floats( );
+
+	daw::io::printf( daw::con_out, "%s is %5.2f%%\n", "The answer", 42.0 );
+	return failed ? 1 : 0;
+}
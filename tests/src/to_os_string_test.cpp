@@ -135,9 +135,142 @@ static_assert( to_os_string<char>( std::numeric_limits<int64_t>::min( ) ) ==
                  "-9223372036854775808",
                "" );
 
+// The limits of each width
+static_assert( to_os_string<char>( std::numeric_limits<int8_t>::min( ) ) ==
+                 "-128",
+               "" );
+static_assert( to_os_string<char>( std::numeric_limits<int8_t>::max( ) ) ==
+                 "127",
+               "" );
+static_assert( to_os_string<char>( std::numeric_limits<int16_t>::min( ) ) ==
+                 "-32768",
+               "" );
+static_assert( to_os_string<char>( std::numeric_limits<int16_t>::max( ) ) ==
+                 "32767",
+               "" );
+static_assert( to_os_string<char>( std::numeric_limits<int32_t>::min( ) ) ==
+                 "-2147483648",
+               "" );
+static_assert( to_os_string<char>( std::numeric_limits<int32_t>::max( ) ) ==
+                 "2147483647",
+               "" );
+static_assert( to_os_string<char>( std::numeric_limits<int64_t>::max( ) ) ==
+                 "9223372036854775807",
+               "" );
+static_assert( to_os_string<char>( std::numeric_limits<uint64_t>::max( ) ) ==
+                 "18446744073709551615",
+               "" );
+
+static_assert( to_os_string<wchar_t>( std::numeric_limits<int8_t>::min( ) ) ==
+                 L"-128",
+               "" );
+static_assert( to_os_string<wchar_t>( std::numeric_limits<int8_t>::max( ) ) ==
+                 L"127",
+               "" );
+static_assert( to_os_string<wchar_t>( std::numeric_limits<int16_t>::min( ) ) ==
+                 L"-32768",
+               "" );
+static_assert( to_os_string<wchar_t>( std::numeric_limits<int16_t>::max( ) ) ==
+                 L"32767",
+               "" );
+static_assert( to_os_string<wchar_t>( std::numeric_limits<int32_t>::min( ) ) ==
+                 L"-2147483648",
+               "" );
+static_assert( to_os_string<wchar_t>( std::numeric_limits<int32_t>::max( ) ) ==
+                 L"2147483647",
+               "" );
+static_assert( to_os_string<wchar_t>( std::numeric_limits<int64_t>::min( ) ) ==
+                 L"-9223372036854775808",
+               "" );
+static_assert( to_os_string<wchar_t>( std::numeric_limits<int64_t>::max( ) ) ==
+                 L"9223372036854775807",
+               "" );
+static_assert( to_os_string<wchar_t>( std::numeric_limits<uint64_t>::max( ) ) ==
+                 L"18446744073709551615",
+               "" );
+
 // Float conversions
 static_assert( to_os_string<char>( 0.1f ) == "0.1", "" );
-static_assert( to_os_string<char>( 0.12 ) == "0.11999999999999998", "" );
+static_assert( to_os_string<char>( 0.12 ) == "0.12", "" );
+static_assert( to_os_string<char>( 0.12, 17 ) == "0.12", "" );
+static_assert( to_os_string<char>( 2.0 / 3.0, 17 ) == "0.66666666666666663",
+               "" );
+static_assert( to_os_string<char>( 3.14159, 3 ) == "3.14", "" );
+static_assert( to_os_string<char>( 1234.5678, 17, 2 ) == "1234.57", "" );
+
+// Scientific and general
+static_assert( to_os_string<char>( daw::as_scientific( 42.0 ) ) == "4.2e1", "" );
+static_assert( to_os_string<char>( daw::as_scientific( 0.0 ) ) == "0e0", "" );
+static_assert( to_os_string<char>( daw::as_general( 0.0 ) ) == "0", "" );
+static_assert( to_os_string<char>( daw::as_scientific( 5.0 ) ) == "5e0", "" );
+static_assert( to_os_string<char>( daw::as_scientific( -0.00125 ) ) ==
+                 "-1.25e-3",
+               "" );
+static_assert( to_os_string<char>( daw::as_scientific( 1.5f ) ) == "1.5e0", "" );
+static_assert( to_os_string<char>( daw::as_general( 1234.5 ) ) == "1234.5", "" );
+static_assert( to_os_string<char>( daw::as_general( 1e6 ) ) == "1e6", "" );
+static_assert( to_os_string<char>( daw::as_general( 100.0 ) ) == "100", "" );
+static_assert( to_os_string<char>( daw::as_general( 0.01 ) ) == "0.01", "" );
+static_assert( to_os_string<char>( daw::as_general( 0.001 ) ) == "1e-3", "" );
+static_assert( to_os_string<wchar_t>( daw::as_general( 1.5e300 ) ) ==
+                 L"1.5e300",
+               "" );
+
+// Fixed precision
+static_assert( to_os_string<char>( daw::as_fixed<2>( 1.005 ) ) == "1.00", "" );
+static_assert( to_os_string<char>( daw::as_fixed<2>( 0.125 ) ) == "0.12", "" );
+static_assert( to_os_string<char>( daw::as_fixed<2>( 0.375 ) ) == "0.38", "" );
+static_assert( to_os_string<char>( daw::as_fixed<0>( 2.5 ) ) == "2", "" );
+static_assert( to_os_string<char>( daw::as_fixed<1>( 9.96 ) ) == "10.0", "" );
+static_assert( to_os_string<char>( daw::as_fixed<3>( -42.0 ) ) == "-42.000",
+               "" );
+#ifdef DAW_IO_HAS_BUILTIN_BIT_CAST
+static_assert( to_os_string<char>( daw::as_fixed<2>( -0.0 ) ) == "-0.00", "" );
+#endif
+static_assert( to_os_string<char>( daw::as_fixed<6>( 1e-7 ) ) == "0.000000",
+               "" );
+static_assert( to_os_string<char>( daw::as_fixed<2>( 1e20 ) ) ==
+                 "100000000000000000000.00",
+               "" );
+static_assert( to_os_string<char>( daw::as_fixed<4>( 0.1f ) ) == "0.1000", "" );
+static_assert( to_os_string<wchar_t>( daw::as_fixed<2>( 19.999 ) ) == L"20.00",
+               "" );
+static_assert( to_os_string<char>( 0.0 ) == "0", "" );
+#ifdef DAW_IO_HAS_BUILTIN_BIT_CAST
+static_assert( to_os_string<char>( -0.0 ) == "-0", "" );
+static_assert( to_os_string<char>( daw::as_scientific( -0.0f ) ) == "-0e0",
+               "" );
+#endif
+static_assert( to_os_string<char>( -1.5 ) == "-1.5", "" );
+static_assert( to_os_string<char>( 1e100 ) == "1e100", "" );
+static_assert( to_os_string<char>( 5e-324 ) == "5e-324", "" );
+static_assert( to_os_string<char>( std::numeric_limits<double>::max( ) ) ==
+                 "1.7976931348623157e308",
+               "" );
+static_assert( to_os_string<char>( 3.4028235e38f ) == "3.4028235e38", "" );
+// Both sides of the float kernel's power of five tables
+static_assert( to_os_string<char>( 1e-9f ) == "1e-9", "" );
+static_assert( to_os_string<char>( 1.1754944e-38f ) == "1.1754944e-38", "" );
+static_assert( to_os_string<char>( 1e-45f ) == "1e-45", "" );
+static_assert( to_os_string<char>( 123456.79f ) == "123456.79", "" );
+static_assert( to_os_string<char>( 2.7182817e20f ) == "2.7182817e20", "" );
+static_assert( to_os_string<wchar_t>( 123.456 ) == L"123.456", "" );
+
+// Maximum formatted sizes
+using ostream_converters::max_formatted_size_v;
+static_assert( max_formatted_size_v<char, int32_t> == 11, "" );
+static_assert( max_formatted_size_v<char, int64_t, char, bool> == 27, "" );
+static_assert( max_formatted_size_v<char, char const( & )[6]> == 5, "" );
+static_assert( max_formatted_size_v<char, double> >=
+                 to_os_string<char>( -2.2250738585072014e-308 ).size( ),
+               "" );
+static_assert( max_formatted_size_v<wchar_t, daw::as_fixed_t<2, double>> >=
+                 to_os_string<wchar_t>( daw::as_fixed<2>(
+                                          -std::numeric_limits<double>::max( ) ) )
+                   .size( ),
+               "" );
+static_assert( !ostream_converters::has_max_formatted_size_v<char, std::string>,
+               "" );
 
 int main( ) {
 